@@ -0,0 +1,120 @@
+/**
+ * @file OneWire.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief 1-Wire bus master tuned for the ESP8266's GPIO16
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Takes the place of the OneWire library (platformio.ini has
+ * `lib_ignore = OneWire`), with the same class and methods, so
+ * DallasTemperature builds against it unchanged - hence the file name.
+ *
+ * ONE_WIRE_BUS is D0/GPIO16, which lives in the RTC block: no interrupt,
+ * and its registers (GP16O/GP16E/GP16I) are slower than the other GPIOs'.
+ * The stock library reaches it through digitalWrite()-style macros and
+ * keeps interrupts off for whole time slots - 65us for a 0 bit, 70us
+ * around each presence pulse - which the encoder and the cleaner's timer1
+ * edges feel.  Here:
+ *   - the line is open drain: GP16O stays low, and a slot only flips the
+ *     output enable in GP16E (one register read-modify-write per edge)
+ *   - slot code is in IRAM and times itself off the CPU cycle counter
+ *   - interrupts are only off where the DS18B20 can't tolerate a stretch:
+ *     a written bit's low (5us for a 1, 65us for a 0 - past 120us it is
+ *     no bit) and a read slot's fall to sample (~10us).  The presence pulse
+ *     is sampled with interrupts on, and the reset is redone if an
+ *     interrupt held the sample past 75us, where a short pulse may be over.
+ * Pins 0..15 work too, through GPES/GPEC/GPI.
+ *
+ * stats() counts slots and the time spent with interrupts off - the 1-Wire
+ * benchmark (env:bench_onewire) reports them per conversion and readout.
+ *
+ * -D ONEWIRE_STOCK (env:bench_onewire_stock) builds against the stock
+ * library instead, for the benchmark to compare: this header hands over to
+ * the library's and src/OneWire.cpp compiles to nothing.
+ */
+#ifdef ONEWIRE_STOCK
+#include_next <OneWire.h>
+#else
+#ifndef ONE_WIRE_H
+#define ONE_WIRE_H
+
+#include <Arduino.h>
+
+// what DallasTemperature looks for
+#define ONEWIRE_SEARCH 1
+#define ONEWIRE_CRC 1
+#define ONEWIRE_CRC16 1
+
+struct OneWireStats
+{
+    uint32_t resets;
+    uint32_t zeros;           ///< 0 bits written
+    uint32_t ones;            ///< 1 bits written
+    uint32_t reads;           ///< read slots
+    uint32_t irqOffCycles;    ///< total time with interrupts off, CPU cycles
+    uint32_t maxIrqOffCycles; ///< longest single window
+};
+
+class OneWire
+{
+public:
+    OneWire() {}
+    explicit OneWire(uint8_t pin) { begin(pin); }
+
+    void begin(uint8_t pin);
+
+    /// Reset pulse; 1 if a device answered with a presence pulse
+    uint8_t reset();
+
+    void select(const uint8_t rom[8]);
+    void skip();
+
+    /// A byte, LSB first.  `power` leaves the bus driven high afterwards
+    /// (parasite powered devices) until depower() or the next slot.
+    void write(uint8_t value, uint8_t power = 0);
+    void write_bytes(const uint8_t *buffer, uint16_t count, bool power = 0);
+    uint8_t read();
+    void read_bytes(uint8_t *buffer, uint16_t count);
+
+    void write_bit(uint8_t bit);
+    uint8_t read_bit();
+
+    void depower();
+
+    void reset_search();
+    void target_search(uint8_t familyCode);
+    bool search(uint8_t *newAddr, bool searchMode = true);
+
+    static uint8_t crc8(const uint8_t *data, uint8_t length);
+    static bool check_crc16(const uint8_t *input, uint16_t length, const uint8_t *invertedCrc, uint16_t crc = 0);
+    static uint16_t crc16(const uint8_t *input, uint16_t length, uint16_t crc = 0);
+
+    static const OneWireStats &stats();
+    static void resetStats();
+
+private:
+    void low();
+    void release();
+    uint8_t level() const;
+    uint32_t irqOff();
+    void irqOn(uint32_t state);
+    void waitUs(uint32_t fromCycles, uint32_t us) const;
+
+    uint8_t _pin = 0;
+    uint16_t _mask = 0;
+    bool _gpio16 = false;
+    bool _powered = false;
+    uint32_t _cyclesPerUs = 80;
+    uint32_t _irqOffAt = 0;
+
+    // search state
+    uint8_t _rom[8] = {};
+    uint8_t _lastDiscrepancy = 0;
+    uint8_t _lastFamilyDiscrepancy = 0;
+    bool _lastDevice = false;
+};
+
+#endif // ONE_WIRE_H
+#endif // ONEWIRE_STOCK
@@ -0,0 +1,47 @@
+/**
+ * @file backlight.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Dimmable backlight, faded by a Ticker
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * timer1 belongs to the pulsed cleaner (cleanerMod.h), so analogWrite() is
+ * out.  The level comes from the ESP8266's sigma-delta modulator instead:
+ * hardware, no timer, no interrupts, on any pin but GPIO16.  Fully off and
+ * fully on detach the modulator and drive the pin plainly.
+ *
+ * A fade is stepped every BACKLIGHT_FADE_STEP_MS by its own Ticker, which
+ * is attached only while a fade runs.  Each step works the level out from
+ * the time since the fade began, so a late step catches up instead of
+ * stretching the fade.  The level goes through a square law on its way to
+ * the modulator, so a straight fade also looks straight.
+ *
+ * The level last sent is cached, and the hardware is only touched when it
+ * changes.  Display::setBacklight() (display.h) is the way in from the
+ * screens.
+ */
+#ifndef BACKLIGHT_H
+#define BACKLIGHT_H
+
+#include <Arduino.h>
+
+#define BACKLIGHT_ON 255
+#define BACKLIGHT_FADE_MS 250      // on and off from the screens
+#define BACKLIGHT_FADE_STEP_MS 10
+#define BACKLIGHT_SIGMA_DELTA_HZ 10000
+
+/// Set the pin up, with the backlight off
+void backlightBegin(uint8_t pin);
+
+/// Head for `level` (0 off .. BACKLIGHT_ON), over `fadeMs`; 0 is at once
+void backlightFade(uint8_t level, uint16_t fadeMs);
+
+uint8_t backlightLevel();  ///< where it is now
+uint8_t backlightTarget(); ///< where it's heading
+
+/// Times the level actually reached the hardware
+uint32_t backlightWrites();
+
+#endif // BACKLIGHT_H
@@ -0,0 +1,120 @@
+/**
+ * @file bathChannel.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief One bath: its sensor, heater, cleaner and the run in progress
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Everything main.cpp used to do for its single bath, as an object, so one
+ * controller can run several.  All the channels' DS18B20s share the 1-Wire
+ * bus (each channel takes one by search order); the relays are GPIOs or
+ * expander pins (outputs.h).
+ *
+ * update() is the only thing that has to run regularly - the Scheduler
+ * calls it.  It never blocks: it collects a finished conversion, teaches the
+ * thermal model, and while a run is going decides the relays:
+ *   - no valid reading: both off, straight away
+ *   - below the ready temperature: heat (or, on the way up, coast once the
+ *     model knows the bath), cleaner off
+ *   - at the ready temperature: heater off, cleaner on
+ * with the relays' dwell, hysteresis and rate limits applied, until the
+ * timer runs out.  The relays act on the sampler's reading smoothed a
+ * little further, so noise at the ready temperature can't hand over to the
+ * cleaner early.  The heater and the cleaner are never on together: each
+ * waits for the other to open (requestExclusive() in relay.h).
+ */
+#ifndef BATH_CHANNEL_H
+#define BATH_CHANNEL_H
+
+#include <Arduino.h>
+#include <DallasTemperature.h>
+#include "tempSampler.h"
+#include "thermalModel.h"
+#include "relay.h"
+
+/// What a channel is doing, for the status line and the resume checkpoint
+enum BathPhase : uint8_t
+{
+    PHASE_IDLE,       ///< not running
+    PHASE_NO_READING, ///< running, but no valid temperature: relays off
+    PHASE_HEAT,
+    PHASE_COAST,      ///< heater off early, the bath coasts up to ready
+    PHASE_WAIT,       ///< inside the hysteresis band or held by the relay limits
+    PHASE_CLEAN,
+    PHASE_DONE,       ///< the timer ran out
+};
+
+class BathChannel
+{
+public:
+    BathChannel(DallasTemperature &sensors, uint8_t sensorIndex, uint8_t heaterPin, uint8_t cleanerPin);
+
+    /// Relays off.  First thing in setup().
+    void begin();
+
+    /// Find this channel's sensor (searches the 1-Wire bus, so not in setup())
+    bool beginSensor();
+
+    /// The temperature the bath has to reach before cleaning starts
+    void setReadyTemperature(float readyF);
+
+    /// Heat, then clean, for `seconds` from now
+    void start(uint32_t seconds);
+
+    /// Carry on a run that was interrupted with `remainingMs` to go
+    void resume(uint32_t remainingMs);
+
+    /// End the run, relays off
+    void stop();
+
+    /// Sample and control; call regularly (the Scheduler does)
+    void update();
+
+    bool running() const { return _running; }
+    long remainingSeconds() const;
+    uint32_t remainingMs() const;
+    long etaSeconds() const { return _etaS; } ///< to ready, -1 unknown, 0 there
+    float temperatureF() const { return _sampler.temperatureF(); }
+    float readyTemperatureF() const { return _readyF; }
+
+    BathPhase phase() const;
+
+    /// A word for the status line: heat, coast, wait, clean, done, idle or --
+    const char *status() const;
+
+    TempSampler &sampler() { return _sampler; }
+    ThermalModel &model() { return _model; }
+    Relay &heater() { return _heater; }
+    Relay &cleaner() { return _cleaner; }
+    const Relay &heater() const { return _heater; }
+    const Relay &cleaner() const { return _cleaner; }
+
+    /// Heater and cleaner on time since boot, for energy.h.  A modulated
+    /// cleaner (MODULATED_PIN) counts the time its pattern drove it.
+    uint64_t heaterOnMicros() const { return _heater.onMicros(); }
+    uint64_t cleanerOnMicros() const;
+
+private:
+    void control(uint32_t nowMs);
+
+    TempSampler _sampler;
+    ThermalModel _model;
+    Relay _heater;
+    Relay _cleaner;
+    float _readyF = 0.0f;
+    uint32_t _startMs = 0;
+    uint32_t _runMs = 0;
+    long _etaS = -1;
+    float _relayF = 0.0f;  // the reading the relays act on
+    float _relayRateFps = 0.0f;
+    uint32_t _relayMs = 0;
+    bool _relayValid = false;
+    bool _reached = false; // at ready once this run: no more coasting
+    bool _running = false;
+    bool _finished = false;
+    bool _coasting = false;
+};
+
+#endif // BATH_CHANNEL_H
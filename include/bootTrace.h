@@ -0,0 +1,39 @@
+/**
+ * @file bootTrace.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Timestamps for each stage of the boot
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * bootMark(F("stage")) at the end of each stage records micros() - which
+ * counts from reset, so the first entry includes the ROM and SDK start up.
+ * Stage names stay in flash; the trace costs 8 bytes of RAM per mark.
+ */
+#ifndef BOOT_TRACE_H
+#define BOOT_TRACE_H
+
+#include <Arduino.h>
+
+#define BOOT_TRACE_MAX 12
+
+struct BootStage
+{
+    const __FlashStringHelper *name;
+    uint32_t endUs; ///< micros() when the stage finished
+};
+
+/// Record the end of a stage (ignored once the trace is full)
+void bootMark(const __FlashStringHelper *stage);
+
+uint8_t bootStageCount();
+const BootStage &bootStage(uint8_t index);
+
+/// How long stage `index` took
+uint32_t bootStageMicros(uint8_t index);
+
+/// One line per stage: duration and time since reset
+void bootTracePrint(Print &out);
+
+#endif // BOOT_TRACE_H
@@ -0,0 +1,72 @@
+/**
+ * @file cleanerMod.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Pulsed and swept sonication, timed by the hardware timer (timer1)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * While the cleaner is on, its pin follows the selected mode instead of
+ * being held high.  A mode is a period with an on time that can ramp from
+ * onStartMs to onEndMs over rampPeriods periods, then stay there or (sweep)
+ * ramp back and repeat:
+ *
+ *      Continuous   always on
+ *      Pulse 2/1    2 s on, 1 s off
+ *      Pulse 1/1    1 s on, 1 s off
+ *      Gentle       0.3 s on in every second, for delicate parts
+ *      Degas        on time ramps 20% -> 100% over 20 s, then stays on
+ *      Sweep        on time sweeps 30% <-> 90% every 10 s
+ *
+ * Every edge is scheduled by timer1 from the previous one (TIM_SINGLE,
+ * re-armed in the interrupt, which makes up for its own lateness), so a
+ * busy loop() - a slow frame, a 1-Wire read - can't stretch a pulse.
+ * The interrupt measures how late each edge was against the CPU cycle
+ * counter; cleanerModJitter() reports the spread.
+ *
+ * The pin is driven straight from the interrupt, so it must be a native
+ * GPIO (0..15).  The relay layer switches it through MODULATED_PIN(gpio),
+ * see outputs.h.  There is one timer1, so there is one modulated output.
+ */
+#ifndef CLEANER_MOD_H
+#define CLEANER_MOD_H
+
+#include <Arduino.h>
+
+struct CleanerMode
+{
+    const char *name;
+    uint16_t periodMs;  ///< 0: continuous
+    uint16_t onStartMs;
+    uint16_t onEndMs;
+    uint8_t rampPeriods; ///< periods to go from onStartMs to onEndMs, 0 for none
+    bool sweep;          ///< ramp back down again, and repeat
+};
+
+struct CleanerJitter
+{
+    uint32_t edges;    ///< edges timed since the mode was (re)started
+    uint16_t minLateUs; ///< earliest an edge came after its due time
+    uint16_t maxLateUs; ///< latest
+    uint16_t jitterUs() const { return edges ? maxLateUs - minLateUs : 0; }
+};
+
+uint8_t cleanerModeCount();
+const CleanerMode &cleanerMode(uint8_t index);
+
+/// Choose the mode; takes effect from the next time the cleaner starts
+void cleanerModSelect(uint8_t index);
+uint8_t cleanerModSelected();
+
+/// Start (on) or stop (off, pin low) the pattern on `gpio`
+void cleanerModWrite(uint8_t gpio, bool on);
+
+/// Edge timing since the pattern last started
+CleanerJitter cleanerModJitter();
+
+/// How long the output has actually been driven on since boot - with a
+/// pattern running that's less than the time the cleaner relay was on
+uint64_t cleanerModOnMicros();
+
+#endif // CLEANER_MOD_H
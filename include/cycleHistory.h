@@ -0,0 +1,145 @@
+/**
+ * @file cycleHistory.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief A record of every cycle, kept in LittleFS, with an index
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Each cycle adds one fixed-size CycleRecord when it ends, and that is the
+ * only write.  Records are appended to HISTORY_CURRENT.  Once that file
+ * holds HISTORY_FILE_RECORDS, it is renamed to HISTORY_PREVIOUS, replacing
+ * the older file, and a new current file is started.  So the log keeps the
+ * last HISTORY_FILE_RECORDS to twice that many cycles, and never copies a
+ * record to make room.
+ *
+ * The index (HISTORY_INDEX) is written with each record.  It is kept in RAM
+ * and holds:
+ *   - how many records each file holds.  Records are fixed size, so the
+ *     n-th newest is one seek away.
+ *   - running totals per preset (HISTORY_PRESETS of them, the least
+ *     recently run dropped first), so the averages cost nothing to show.
+ * If the index is missing, corrupt, or doesn't match the files (power cut
+ * between the two writes), begin() rebuilds it from the records.  The
+ * totals then cover only the cycles still in the log.
+ *
+ * The files share the filesystem with the web page in .data_dir, and
+ * uploading that image (`pio run -t uploadfs`) erases the history.
+ */
+#ifndef CYCLE_HISTORY_H
+#define CYCLE_HISTORY_H
+
+#include <Arduino.h>
+#include "timerPresets.h"
+#include "energy.h"
+
+#define HISTORY_CURRENT "/history0.bin"
+#define HISTORY_PREVIOUS "/history1.bin"
+#define HISTORY_INDEX "/history.idx"
+#define HISTORY_FILE_RECORDS 128 // 2.5 kB a file
+#define HISTORY_PRESETS 12
+#define HISTORY_NEVER 0xFFFF     // the bath never got to temperature
+
+/// How a cycle ended
+enum CycleEnd : uint8_t
+{
+    CYCLE_FINISHED, ///< the timer ran out
+    CYCLE_STOPPED,  ///< stopped with a long press
+    CYCLE_LOST,     ///< cut short by a reset and not resumed
+};
+
+struct CycleRecord
+{
+    uint32_t seq;        ///< cycle number, from 1
+    uint32_t startTime;  ///< time(); counts from boot until the clock is set, 0 unknown
+    uint16_t runS;
+    uint16_t toTempS;    ///< until every bath had been ready, or HISTORY_NEVER
+    uint16_t energyDWh;  ///< heater and cleaner, tenths of a Wh
+    Preset preset;       ///< time and set temperature
+    uint8_t overshootDF; ///< peak above the ready temperature, tenths of a F
+    uint8_t end;         ///< CycleEnd
+    uint16_t crc;
+};
+static_assert(sizeof(CycleRecord) == 20, "history records are a fixed 20 bytes");
+
+/// One preset's running totals
+struct PresetStats
+{
+    Preset preset;
+    uint16_t cycles;      ///< finished or stopped (lost cycles carry no data)
+    uint32_t lastSeq;
+    uint32_t toTempS;     ///< summed over the `reached` cycles
+    uint16_t reached;
+    uint16_t reserved;
+    uint32_t overshootDF;
+    uint32_t energyDWh;
+
+    uint16_t averageToTempS() const { return reached ? toTempS / reached : HISTORY_NEVER; }
+    float averageOvershootF() const { return cycles ? overshootDF / (10.0f * cycles) : 0.0f; }
+    float averageWh() const { return cycles ? energyDWh / (10.0f * cycles) : 0.0f; }
+};
+
+/**
+ * @brief Follows a running cycle for its record
+ *
+ * start() when the cycle begins.  sample() each bath's valid readings
+ * while it runs.  finish() builds the record when it ends.
+ */
+class CycleTracker
+{
+public:
+    void start(Preset preset, uint8_t channels);
+    void sample(uint8_t channel, float tempF, float readyF);
+    CycleRecord finish(CycleEnd end, const EnergyUse &energy) const;
+
+private:
+    Preset _preset = {};
+    uint32_t _startTime = 0;
+    uint32_t _startMs = 0;
+    uint32_t _toTempMs = 0;
+    float _peakOverF = 0.0f;
+    uint8_t _channels = 0;
+    uint8_t _ready = 0; ///< a bit per bath that has been ready
+    bool _reached = false;
+};
+
+class CycleHistory
+{
+public:
+    /// Mount LittleFS and load the index, or rebuild it from the records
+    bool begin();
+
+    bool ready() const { return _mounted; }
+
+    /// Append `record` (its seq and crc are filled in) and update the index
+    bool add(CycleRecord &record);
+
+    /// Records in the log
+    uint16_t count() const { return _index.records[0] + _index.records[1]; }
+
+    /// The record `back` cycles ago, 0 the newest
+    bool read(uint16_t back, CycleRecord &record) const;
+
+    /// The totals for `preset`, nullptr if it has none
+    const PresetStats *stats(Preset preset) const;
+
+private:
+    struct Index
+    {
+        uint32_t magic;
+        uint32_t lastSeq;
+        uint16_t records[2]; ///< in HISTORY_CURRENT, HISTORY_PREVIOUS
+        PresetStats preset[HISTORY_PRESETS];
+        uint32_t crc;
+    };
+
+    bool rebuild();
+    bool saveIndex();
+    void account(const CycleRecord &record);
+
+    Index _index = {};
+    bool _mounted = false;
+};
+
+#endif // CYCLE_HISTORY_H
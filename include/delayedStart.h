@@ -0,0 +1,62 @@
+/**
+ * @file delayedStart.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief "Ready in N minutes": heat late enough that the baths are ready on time
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Starting the timer heats at once, and a bath that gets to temperature
+ * long before anyone needs it sits there with the heater cycling to hold
+ * it.  A delayed start is told when the bath is wanted instead, and leaves
+ * the heaters off until the heat-up takes about as long as is left.
+ *
+ * Each pass, due() is given the longest heat-up any bath still needs, from
+ * its thermal model (ThermalModel::etaSeconds() with the heater off, so the
+ * dead time is counted).  That lead is padded by DELAY_MARGIN_PERCENT and
+ * DELAY_MARGIN_S for what the model gets wrong (a colder room, a fuller
+ * bath), and the heaters go on once the time left is no more than that.
+ * The lead is worked out again every pass, so a bath cooling while it
+ * waits starts sooner.  Without a lead (the model isn't trained yet, or
+ * says the heater can't get there) it is due at once, which is what
+ * starting the timer would have done.
+ *
+ * scripts/delay_sim.cpp checks it against heating at once.
+ */
+#ifndef DELAYED_START_H
+#define DELAYED_START_H
+
+#include <Arduino.h>
+
+#define DELAY_MARGIN_PERCENT 10 // of the predicted heat-up
+#define DELAY_MARGIN_S 120      // on top of that
+#define DELAY_STEP_MIN 5        // one encoder step on the "Ready In" page
+#define DELAY_MAX_MIN 720
+
+class DelayedStart
+{
+public:
+    /// The baths are wanted `readyInS` from `nowMs`
+    void arm(uint32_t nowMs, uint32_t readyInS);
+
+    /// Seconds until they are wanted, 0 once that has passed
+    uint32_t remainingS(uint32_t nowMs) const;
+
+    /**
+     * @brief Whether to switch the heaters on now
+     *
+     * @param leadS the longest heat-up still needed, seconds; -1 if unknown
+     */
+    bool due(uint32_t nowMs, long leadS);
+
+    /// The padded lead due() was last given, -1 if it had none
+    long leadS() const { return _leadS; }
+
+private:
+    uint32_t _armedMs = 0;
+    uint32_t _delayMs = 0;
+    long _leadS = -1;
+};
+
+#endif // DELAYED_START_H
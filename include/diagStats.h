@@ -0,0 +1,44 @@
+/**
+ * @file diagStats.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Loop rate and Ticker timing, for the diagnostics page
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Two hooks: diagLoopPass() once per pass of whichever page loop is running
+ * (handleLoop() calls it), and diagTick() first thing in the 10ms Ticker
+ * callback.  Each is a micros() read and a few compares, so they stay in
+ * release builds.  Once a second the counts roll over into DiagStats.
+ *
+ * Ticker callbacks run between loop() passes, never in the middle of one,
+ * so a late tick means something in the loop held on too long - a frame
+ * flush, a 1-Wire read, a flash write.  Jitter is how far a tick's period
+ * strayed from DIAG_TICK_US.
+ */
+#ifndef DIAG_STATS_H
+#define DIAG_STATS_H
+
+#include <Arduino.h>
+
+#define DIAG_TICK_US 10000 // t.attach_ms(10, ...) in setup()
+
+struct DiagStats
+{
+    uint16_t loopsPerSecond;  ///< page loop passes in the last second
+    uint32_t maxPassUs;       ///< longest gap between passes, last second
+    uint16_t ticksPerSecond;  ///< Ticker callbacks in the last second
+    uint32_t tickJitterUs;    ///< worst period error, last second
+    uint32_t maxTickJitterUs; ///< worst since boot
+};
+
+/// Once per pass through a page loop
+void diagLoopPass();
+
+/// First thing in the Ticker callback
+void diagTick();
+
+const DiagStats &diagStats();
+
+#endif // DIAG_STATS_H
@@ -0,0 +1,388 @@
+/**
+ * @file display.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Compile-time selected display backend
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Over time this project has driven its panel three different ways (see the
+ * old src/main.cpp.N sketches): U8g2, Adafruit_PCD8544 and a LiquidCrystal_I2C
+ * character display.  The screens are written once against Display<Backend>
+ * and the backend is a template parameter, picked with DISPLAY_BACKEND:
+ *
+ *      -D DISPLAY_BACKEND=DISPLAY_U8G2      Nokia 5110 through U8g2 (default)
+ *      -D DISPLAY_BACKEND=DISPLAY_PCD8544   Nokia 5110 through Adafruit_PCD8544
+ *      -D DISPLAY_BACKEND=DISPLAY_LCD_I2C   HD44780 + PCF8574 through LiquidCrystal_I2C
+ *
+ * Everything resolves at compile time - no virtual calls between the screens
+ * and the panel.  Screens work on a grid of character cells (COLS x ROWS)
+ * and hand their drawing code to frame(), which may run it more than once:
+ * in U8g2 page buffer mode (DISPLAY_PAGE_BUFFER) the frame is drawn a strip
+ * at a time, so the drawing code must only draw.  A backend provides:
+ *
+ *      static constexpr uint8_t COLS, ROWS;
+ *      static constexpr bool HAS_INVERSE;      // can draw reverse video
+ *      static constexpr uint16_t BUFFER_BYTES; // frame memory the driver holds
+ *      static constexpr uint8_t INIT_BIAS;     // the bias begin() leaves the controller at
+ *      void begin();
+ *      void control(const PanelControl &control); // contrast and bias, in as
+ *                                              // few transfers as it can
+ *      uint32_t transactions() const;          // bus transfers started so far
+ *      void firstPage();                       // start a new frame
+ *      void drawText(uint8_t col, uint8_t row, const char *text, bool inverse);
+ *      void fillRow(uint8_t row);              // full width reverse video bar
+ *      void drawImage(const uint8_t *frame);   // 84x48 PCD8544-order frame in PROGMEM
+ *      bool nextPage();                        // send what was drawn, true if
+ *                                              // there is another page to draw
+ *
+ * and, for compose() - retained drawing of widgets.h, which repaints only
+ * what changed:
+ *
+ *      static constexpr bool CAN_RETAIN;       // the frame stays in memory
+ *      void clearCells(uint8_t col, uint8_t row, uint8_t width, uint8_t height);
+ *      void flushCells();                      // send what changed since the last
+ *
+ * The panel's settings - contrast, bias and the backlight - are properties
+ * of the Display.  Contrast and bias are cached and go to the controller
+ * with the next frame() or compose(), and only if they changed since they
+ * were last sent: however often a screen sets them, the panel hears about
+ * it once per frame at most.  The backlight is a pin, not the panel's bus;
+ * it is faded in the background (backlight.h).
+ */
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include <Arduino.h>
+#include "backlight.h"
+
+#define DISPLAY_U8G2 1
+#define DISPLAY_PCD8544 2
+#define DISPLAY_LCD_I2C 3
+
+#ifndef DISPLAY_BACKEND
+#define DISPLAY_BACKEND DISPLAY_U8G2
+#endif
+
+/// The controller settings a backend sends together
+struct PanelControl
+{
+    uint8_t contrast; ///< 0..255
+    uint8_t bias;     ///< 0..7
+
+    bool operator==(const PanelControl &other) const
+    {
+        return contrast == other.contrast && bias == other.bias;
+    }
+};
+
+template <class Backend>
+class Display
+{
+public:
+    static constexpr uint8_t COLS = Backend::COLS;
+    static constexpr uint8_t ROWS = Backend::ROWS;
+
+    /// Called after every frame with when it started and finished (micros())
+    /// and the content hash of what was drawn
+    typedef void (*FrameHook)(uint32_t startUs, uint32_t endUs, uint16_t hash);
+
+    template <typename... Args>
+    explicit Display(Args... args) : _backend(args...) {}
+
+    void begin() { _backend.begin(); }
+
+    /// Sent with the next frame, if it changed
+    void setContrast(uint8_t contrast) { _control.contrast = contrast; }
+    void setBias(uint8_t bias) { _control.bias = min<uint8_t>(bias, 7); }
+    uint8_t contrast() const { return _control.contrast; }
+    uint8_t bias() const { return _control.bias; }
+
+    /// 0 off .. BACKLIGHT_ON, faded over `fadeMs`
+    void setBacklight(uint8_t level, uint16_t fadeMs = 0) { backlightFade(level, fadeMs); }
+    uint8_t backlight() const { return backlightTarget(); }
+
+    /// Draw a whole frame and send it to the panel.  `draw` is called once
+    /// per page with the cursor homed and must have no side effects.
+    template <class F>
+    void frame(F draw)
+    {
+        uint32_t start = micros();
+        uint32_t flushUs = 0;
+        uint8_t pages = 0;
+        bool more;
+        applyControl();
+        _backend.firstPage();
+        do
+        {
+            _col = 0;
+            _row = 0;
+            _inverse = false;
+            _hash = HASH_SEED;
+            draw();
+            uint32_t flushStart = micros();
+            more = _backend.nextPage();
+            flushUs += micros() - flushStart;
+            pages++;
+        } while (more);
+        _flushUs = flushUs;
+        _frameUs = micros() - start;
+        _pages = pages;
+        _frames++;
+        if (_hook)
+        {
+            _hook(start, start + _frameUs, _hash);
+        }
+        _composed = nullptr;
+    }
+
+    /// Draw a screen made of widgets (widgets.h, or arrays of them),
+    /// retained: only the widgets that changed since the last call are
+    /// cleared, redrawn and sent.  The first call for a screen (told apart
+    /// by its first widget, or after frame() or invalidate()) paints it
+    /// all.  Backends that can't keep the frame (U8g2 page buffer mode)
+    /// get a whole frame, but only when something changed.
+    template <class... Widgets>
+    void compose(Widgets &...widgets)
+    {
+        static_assert(sizeof...(Widgets) > 0, "compose() needs widgets");
+        applyControl(); // even when there is nothing to draw
+        const void *const screens[] = {&widgets...};
+        const bool fresh = screens[0] != _composed;
+        bool changed = fresh;
+        (each(widgets, [&](auto &w)
+        {
+            if (fresh)
+            {
+                w.invalidate();
+            }
+            changed |= w.dirty();
+        }), ...);
+        if (!changed)
+        {
+            return;
+        }
+
+        if (!Backend::CAN_RETAIN)
+        {
+            frame([&]
+            {
+                (each(widgets, [&](auto &w) { drawWidget(w); }), ...);
+            });
+            (each(widgets, [](auto &w) { w.clean(); }), ...);
+            _composed = screens[0];
+            return;
+        }
+
+        uint32_t start = micros();
+        if (fresh)
+        {
+            _backend.firstPage();
+        }
+        _hash = HASH_SEED;
+        (each(widgets, [&](auto &w)
+        {
+            if (w.dirty())
+            {
+                if (!fresh)
+                {
+                    _backend.clearCells(w.col(), w.row(), w.width(), w.height());
+                }
+                drawWidget(w);
+                w.clean();
+            }
+        }), ...);
+        uint32_t flushStart = micros();
+        if (fresh)
+        {
+            _backend.nextPage();
+        }
+        else
+        {
+            _backend.flushCells();
+        }
+        _flushUs = micros() - flushStart;
+        _frameUs = micros() - start;
+        _pages = 1;
+        _frames++;
+        if (_hook)
+        {
+            _hook(start, start + _frameUs, _hash);
+        }
+        _composed = screens[0];
+    }
+
+    /// The next compose() repaints the whole screen
+    void invalidate() { _composed = nullptr; }
+
+    void setCursor(uint8_t col, uint8_t row)
+    {
+        _col = col;
+        _row = row;
+    }
+
+    /// Following print()s are drawn in reverse video (if the backend can)
+    void setInverse(bool inverse) { _inverse = inverse; }
+
+    void print(const char *text)
+    {
+        mix(_col | (_row << 5) | (_inverse << 7));
+        for (const char *c = text; *c; c++)
+        {
+            mix(*c);
+        }
+        _backend.drawText(_col, _row, text, _inverse);
+        _col += strlen(text);
+    }
+
+    void print(char c)
+    {
+        char text[2] = {c, '\0'};
+        print(text);
+    }
+
+    void print(int value) { print(static_cast<long>(value)); }
+    void print(unsigned int value) { print(static_cast<unsigned long>(value)); }
+
+    void print(long value)
+    {
+        char text[12];
+        ltoa(value, text, 10);
+        print(text);
+    }
+
+    void print(unsigned long value)
+    {
+        char text[12];
+        ultoa(value, text, 10);
+        print(text);
+    }
+
+    void print(float value, uint8_t decimals = 2)
+    {
+        char text[16];
+        dtostrf(value, 0, decimals, text);
+        print(text);
+    }
+
+    /// A whole screen image from scripts/asset_compiler.py (assetsTable.h).
+    /// Character panels can't show it and draw nothing.
+    void image(const uint8_t *frame)
+    {
+        uintptr_t address = reinterpret_cast<uintptr_t>(frame);
+        mix(address);
+        mix(address >> 8);
+        _backend.drawImage(frame);
+    }
+
+    /// A menu line: reverse video bar when selected, or a '>' marker on
+    /// panels that can't do reverse video
+    void menuItem(uint8_t row, const char *label, bool selected)
+    {
+        mix(row | (selected << 7));
+        for (const char *c = label; *c; c++)
+        {
+            mix(*c);
+        }
+        if (Backend::HAS_INVERSE)
+        {
+            if (selected)
+            {
+                _backend.fillRow(row);
+            }
+            _backend.drawText(0, row, label, selected);
+        }
+        else
+        {
+            _backend.drawText(0, row, selected ? ">" : " ", false);
+            _backend.drawText(1, row, label, false);
+        }
+    }
+
+    uint32_t flushMicros() const { return _flushUs; } ///< last frame, sending to the panel
+    uint32_t frameMicros() const { return _frameUs; } ///< last frame, drawing and sending
+    uint8_t pages() const { return _pages; }          ///< draw passes the last frame took
+    uint32_t frames() const { return _frames; }
+    uint32_t transactions() const { return _backend.transactions(); } ///< panel bus transfers
+    uint32_t controlWrites() const { return _controlWrites; }          ///< contrast/bias updates sent
+    static constexpr uint16_t bufferBytes() { return Backend::BUFFER_BYTES; }
+
+    /// Hash of everything the last frame drew: equal hashes, same picture
+    uint16_t contentHash() const { return _hash; }
+    void onFrame(FrameHook hook) { _hook = hook; }
+
+    Backend &backend() { return _backend; }
+
+private:
+    static constexpr uint16_t HASH_SEED = 0xFFFF;
+
+    void applyControl()
+    {
+        if (!(_control == _applied))
+        {
+            _backend.control(_control);
+            _applied = _control;
+            _controlWrites++;
+        }
+    }
+
+    template <class W, class F>
+    static void each(W &widget, F f) { f(widget); }
+
+    template <class W, size_t N, class F>
+    static void each(W (&widgets)[N], F f)
+    {
+        for (W &widget : widgets)
+        {
+            f(widget);
+        }
+    }
+
+    template <class W>
+    void drawWidget(const W &widget)
+    {
+        _col = widget.col();
+        _row = widget.row();
+        _inverse = false;
+        widget.draw(*this);
+    }
+
+    // CRC-16/CCITT step, a few cycles per character drawn
+    void mix(uint8_t value)
+    {
+        uint16_t x = (_hash >> 8) ^ value;
+        x ^= x >> 4;
+        _hash = (_hash << 8) ^ (x << 12) ^ (x << 5) ^ x;
+    }
+
+    Backend _backend;
+    FrameHook _hook = nullptr;
+    PanelControl _control = {0, Backend::INIT_BIAS}; // the bias stays as the driver set it up
+    PanelControl _applied = {0, 0xFF};               // never sent: the first frame sends it
+    uint32_t _controlWrites = 0;
+    const void *_composed = nullptr; // first widget of the screen compose() last drew
+    uint32_t _flushUs = 0;
+    uint32_t _frameUs = 0;
+    uint32_t _frames = 0;
+    uint8_t _pages = 0;
+    uint16_t _hash = HASH_SEED;
+    uint8_t _col = 0;
+    uint8_t _row = 0;
+    bool _inverse = false;
+};
+
+#if DISPLAY_BACKEND == DISPLAY_U8G2
+#include "displayU8g2.h"
+typedef U8g2Backend DisplayBackend;
+#elif DISPLAY_BACKEND == DISPLAY_PCD8544
+#include "displayPcd8544.h"
+typedef Pcd8544Backend DisplayBackend;
+#elif DISPLAY_BACKEND == DISPLAY_LCD_I2C
+#include "displayLcdI2c.h"
+typedef LcdI2cBackend DisplayBackend;
+#else
+#error "Unknown DISPLAY_BACKEND"
+#endif
+
+#endif // DISPLAY_H
@@ -0,0 +1,132 @@
+/**
+ * @file displayLcdI2c.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Display backend: HD44780 character LCD on a PCF8574 I2C backpack
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The driver main.cpp.6 used.  The panel keeps its own characters, so the
+ * backend keeps two copies of the screen and nextPage() only sends the cells
+ * that changed - the I2C bus is slow (~0.5ms per character at 100kHz).
+ *
+ * No reverse video: menus mark the selection with '>' instead.  I2C runs on
+ * the pins the SPI panel would use (it isn't fitted when this one is), and a
+ * relay expander (outputs.h) has to share them.
+ *
+ * lib_deps: marcoschwartz/LiquidCrystal_I2C
+ */
+#ifndef DISPLAY_LCD_I2C_H
+#define DISPLAY_LCD_I2C_H
+
+#include <Wire.h>
+#include <LiquidCrystal_I2C.h>
+
+#ifndef LCD_I2C_ADDRESS
+#define LCD_I2C_ADDRESS 0x27
+#endif
+#ifndef LCD_I2C_COLS
+#define LCD_I2C_COLS 20
+#endif
+#ifndef LCD_I2C_ROWS
+#define LCD_I2C_ROWS 4
+#endif
+
+class LcdI2cBackend
+{
+public:
+    static constexpr uint8_t COLS = LCD_I2C_COLS;
+    static constexpr uint8_t ROWS = LCD_I2C_ROWS;
+    static constexpr bool HAS_INVERSE = false;
+    static constexpr uint16_t BUFFER_BYTES = 2 * LCD_I2C_COLS * LCD_I2C_ROWS;
+    static constexpr uint8_t INIT_BIAS = 0; // no bias to set
+    static constexpr bool CAN_RETAIN = true;
+
+    LcdI2cBackend(uint8_t sda, uint8_t scl)
+        : _lcd(LCD_I2C_ADDRESS, COLS, ROWS), _sda(sda), _scl(scl)
+    {
+    }
+
+    void begin()
+    {
+        Wire.pins(_sda, _scl); // init() calls Wire.begin() on the default pins
+        _lcd.init();
+        _lcd.backlight();
+        memset(_shown, ' ', sizeof(_shown));
+        _lcd.clear();
+    }
+
+    void control(const PanelControl &control) {} // contrast is the trimpot on the backpack
+
+    /// I2C writes to the PCF8574: a character or a cursor move is two
+    /// nibbles, each written, strobed high and strobed low
+    uint32_t transactions() const { return _transfers; }
+
+    void firstPage() { memset(_next, ' ', sizeof(_next)); }
+
+    void drawText(uint8_t col, uint8_t row, const char *text, bool inverse)
+    {
+        if (row >= ROWS)
+        {
+            return;
+        }
+        for (; *text && col < COLS; text++, col++)
+        {
+            _next[row][col] = *text;
+        }
+    }
+
+    void fillRow(uint8_t row) {}
+
+    void drawImage(const uint8_t *frame) {}
+
+    bool nextPage()
+    {
+        for (uint8_t row = 0; row < ROWS; row++)
+        {
+            int8_t cursor = -1; // where the LCD's cursor is on this row, -1 unknown
+            for (uint8_t col = 0; col < COLS; col++)
+            {
+                if (_next[row][col] == _shown[row][col])
+                {
+                    continue;
+                }
+                if (cursor != col)
+                {
+                    _lcd.setCursor(col, row);
+                    _transfers += 6;
+                }
+                _lcd.write(_next[row][col]);
+                _transfers += 6;
+                _shown[row][col] = _next[row][col];
+                cursor = col + 1;
+            }
+        }
+        return false;
+    }
+
+    void clearCells(uint8_t col, uint8_t row, uint8_t width, uint8_t height)
+    {
+        for (uint8_t r = row; r < row + height && r < ROWS; r++)
+        {
+            for (uint8_t c = col; c < col + width && c < COLS; c++)
+            {
+                _next[r][c] = ' ';
+            }
+        }
+    }
+
+    // nextPage() only sends what changed anyway
+    void flushCells() { nextPage(); }
+
+private:
+    LiquidCrystal_I2C _lcd;
+    char _next[ROWS][COLS];
+    char _shown[ROWS][COLS];
+    uint8_t _sda;
+    uint8_t _scl;
+    uint32_t _transfers = 0;
+};
+
+#endif // DISPLAY_LCD_I2C_H
@@ -0,0 +1,117 @@
+/**
+ * @file displayPcd8544.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Display backend: Nokia 5110 (PCD8544) through Adafruit_PCD8544
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The driver main.cpp.2 and main.cpp.3 used.  Adafruit_GFX's built in 5x7
+ * font in 6x8 cells gives 14 x 6 cells on the 84x48 panel.
+ *
+ * lib_deps: adafruit/Adafruit PCD8544 Nokia 5110 LCD library, adafruit/Adafruit GFX Library
+ */
+#ifndef DISPLAY_PCD8544_H
+#define DISPLAY_PCD8544_H
+
+#include <Adafruit_GFX.h>
+#include <Adafruit_PCD8544.h>
+
+class Pcd8544Backend
+{
+public:
+    static constexpr uint8_t COLS = 14;
+    static constexpr uint8_t ROWS = 6;
+    static constexpr bool HAS_INVERSE = true;
+    static constexpr uint16_t BUFFER_BYTES = 504; // inside Adafruit_PCD8544
+    static constexpr uint8_t INIT_BIAS = 4;       // BS=4, 1:40: Adafruit_PCD8544::begin()'s default
+
+    static constexpr uint8_t CELL_W = 6;
+    static constexpr uint8_t CELL_H = 8;
+    static constexpr bool CAN_RETAIN = true;
+
+    Pcd8544Backend(int8_t clock, int8_t data, int8_t dc, int8_t cs, int8_t reset)
+        : _lcd(clock, data, dc, cs, reset)
+    {
+    }
+
+    void begin()
+    {
+        _lcd.begin();
+        _lcd.setTextSize(1);
+        _lcd.setTextWrap(false);
+    }
+
+    /// The library sets each on its own (three commands, three transfers),
+    /// so only what changed is sent
+    void control(const PanelControl &control)
+    {
+        if (control.contrast != _sent.contrast)
+        {
+            _lcd.setContrast(control.contrast >> 1); // the controller's Vop is 7 bits
+            _transfers += 3;
+        }
+        if (control.bias != _sent.bias)
+        {
+            _lcd.setBias(control.bias);
+            _transfers += 3;
+        }
+        _sent = control;
+    }
+
+    uint32_t transactions() const { return _transfers; }
+
+    void firstPage() { _lcd.clearDisplay(); }
+
+    void drawText(uint8_t col, uint8_t row, const char *text, bool inverse)
+    {
+        if (row >= ROWS)
+        {
+            return;
+        }
+        if (inverse)
+        {
+            _lcd.setTextColor(WHITE, BLACK);
+        }
+        else
+        {
+            _lcd.setTextColor(BLACK);
+        }
+        _lcd.setCursor(col * CELL_W, row * CELL_H);
+        _lcd.print(text);
+    }
+
+    void fillRow(uint8_t row) { _lcd.fillRect(0, row * CELL_H, COLS * CELL_W, CELL_H, BLACK); }
+
+    // the library's buffer is in controller order too
+    void drawImage(const uint8_t *frame) { memcpy_P(_lcd.getPixelBuffer(), frame, 504); }
+
+    bool nextPage()
+    {
+        display();
+        return false;
+    }
+
+    void clearCells(uint8_t col, uint8_t row, uint8_t width, uint8_t height)
+    {
+        _lcd.fillRect(col * CELL_W, row * CELL_H, width * CELL_W, height * CELL_H, WHITE);
+    }
+
+    // the library only sends whole frames
+    void flushCells() { display(); }
+
+private:
+    // per bank: Y address, X address, then the 84 bytes, each a transfer
+    void display()
+    {
+        _lcd.display();
+        _transfers += 6 * 3;
+    }
+
+    Adafruit_PCD8544 _lcd;
+    PanelControl _sent = {40 << 1, INIT_BIAS}; // what begin() leaves it at
+    uint32_t _transfers = 0;
+};
+
+#endif // DISPLAY_PCD8544_H
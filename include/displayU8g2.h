@@ -0,0 +1,186 @@
+/**
+ * @file displayU8g2.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Display backend: Nokia 5110 (PCD8544) through U8g2, software SPI
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * 84x48 pixels in the 6x10 font on a 9 pixel row pitch gives 14 x 5 cells.
+ *
+ * By default U8g2 keeps the whole 504 byte frame in RAM.  Building with
+ *
+ *      -D DISPLAY_PAGE_BUFFER=1    one 84x8 page    (84 bytes, 6 draw passes)
+ *      -D DISPLAY_PAGE_BUFFER=2    two 84x8 pages   (168 bytes, 3 draw passes)
+ *
+ * uses U8g2's page buffer mode instead: the frame is drawn and sent a strip
+ * at a time, trading draw time for ~400 bytes of DRAM.
+ */
+#ifndef DISPLAY_U8G2_H
+#define DISPLAY_U8G2_H
+
+#include <U8g2lib.h>
+
+#ifndef DISPLAY_PAGE_BUFFER
+#define DISPLAY_PAGE_BUFFER 0 // 0 = full frame buffer
+#endif
+
+#if DISPLAY_PAGE_BUFFER == 0
+typedef U8G2_PCD8544_84X48_F_4W_SW_SPI U8g2Pcd8544;
+#elif DISPLAY_PAGE_BUFFER == 1
+typedef U8G2_PCD8544_84X48_1_4W_SW_SPI U8g2Pcd8544;
+#elif DISPLAY_PAGE_BUFFER == 2
+typedef U8G2_PCD8544_84X48_2_4W_SW_SPI U8g2Pcd8544;
+#else
+#error "DISPLAY_PAGE_BUFFER must be 0, 1 or 2"
+#endif
+
+class U8g2Backend
+{
+public:
+    static constexpr uint8_t COLS = 14;
+    static constexpr uint8_t ROWS = 5;
+    static constexpr bool HAS_INVERSE = true;
+    static constexpr uint16_t BUFFER_BYTES = 84 * (DISPLAY_PAGE_BUFFER ? DISPLAY_PAGE_BUFFER : 6);
+    static constexpr uint8_t INIT_BIAS = 3; // BS=3, 1:48: 0x13 in U8g2's PCD8544 init sequence
+
+    static constexpr uint8_t CELL_W = 6;
+    static constexpr uint8_t CELL_H = 9;
+    static constexpr uint8_t BASELINE = 7; // from the top of the cell
+
+    // retained drawing (Display::compose) needs the whole frame in RAM
+    static constexpr bool CAN_RETAIN = DISPLAY_PAGE_BUFFER == 0;
+
+    U8g2Backend(uint8_t clock, uint8_t data, uint8_t cs, uint8_t dc, uint8_t reset)
+        : _u8g2(U8G2_R0, clock, data, cs, dc, reset)
+    {
+    }
+
+    void begin()
+    {
+        _u8g2.begin();
+        _u8g2.setFont(u8g2_font_6x10_tf);
+        _u8g2.setFontMode(1); // transparent, so reverse video text works
+
+        // count transfers on their way to the byte level SPI driver
+        u8x8_t *u8x8 = _u8g2.getU8x8();
+        _byteCb = u8x8->byte_cb;
+        u8x8->byte_cb = countTransfers;
+    }
+
+    /// Vop and bias are both in the PCD8544's extended instruction set, so
+    /// one transfer sets the two and switches back (U8g2's setContrast()
+    /// would take one of its own)
+    void control(const PanelControl &control)
+    {
+        u8x8_t *u8x8 = _u8g2.getU8x8();
+        u8x8_cad_StartTransfer(u8x8);
+        u8x8_cad_SendCmd(u8x8, 0x21);                           // extended instructions
+        u8x8_cad_SendCmd(u8x8, 0x80 | (control.contrast >> 1)); // Vop, 7 bits
+        u8x8_cad_SendCmd(u8x8, 0x10 | control.bias);
+        u8x8_cad_SendCmd(u8x8, 0x20);                           // basic instructions
+        u8x8_cad_EndTransfer(u8x8);
+    }
+
+    uint32_t transactions() const { return _transfers; }
+
+    // in full buffer mode U8g2 treats the whole frame as one page
+    void firstPage() { _u8g2.firstPage(); }
+
+    void drawText(uint8_t col, uint8_t row, const char *text, bool inverse)
+    {
+        if (row >= ROWS)
+        {
+            return;
+        }
+        uint8_t x = col * CELL_W;
+        uint8_t y = row * CELL_H;
+        if (inverse)
+        {
+            _u8g2.setDrawColor(1);
+            _u8g2.drawBox(x, y, strlen(text) * CELL_W, CELL_H);
+            _u8g2.setDrawColor(0);
+        }
+        _u8g2.drawStr(x, y + BASELINE, text);
+        _u8g2.setDrawColor(1);
+    }
+
+    void fillRow(uint8_t row)
+    {
+        _u8g2.setDrawColor(1);
+        _u8g2.drawBox(0, row * CELL_H, COLS * CELL_W, CELL_H);
+    }
+
+    /// The PCD8544 frame is in U8g2's own tile layout already, so this is a
+    /// copy of whichever banks the buffer currently holds
+    void drawImage(const uint8_t *frame)
+    {
+        uint8_t *buffer = _u8g2.getBufferPtr();
+        uint16_t stride = _u8g2.getBufferTileWidth() * 8;
+        uint8_t first = _u8g2.getBufferCurrTileRow();
+        for (uint8_t bank = 0; bank < _u8g2.getBufferTileHeight() && first + bank < 6; bank++)
+        {
+            memcpy_P(buffer + bank * stride, frame + (first + bank) * 84, 84);
+        }
+    }
+
+    bool nextPage() { return _u8g2.nextPage(); }
+
+    void clearCells(uint8_t col, uint8_t row, uint8_t width, uint8_t height)
+    {
+        uint8_t x = col * CELL_W;
+        uint8_t y = row * CELL_H;
+        uint8_t w = width * CELL_W;
+        uint8_t h = height * CELL_H;
+        _u8g2.setDrawColor(0);
+        _u8g2.drawBox(x, y, w, h);
+        _u8g2.setDrawColor(1);
+
+        // grow the area to send, in the controller's 8x8 tiles
+        _tileX0 = min<uint8_t>(_tileX0, x / 8);
+        _tileY0 = min<uint8_t>(_tileY0, y / 8);
+        _tileX1 = max<uint8_t>(_tileX1, min<int>((x + w + 7) / 8, TILES_W));
+        _tileY1 = max<uint8_t>(_tileY1, min<int>((y + h + 7) / 8, TILES_H));
+    }
+
+    /// Send only the tiles clearCells() touched
+    void flushCells()
+    {
+        if (_tileX1 > _tileX0 && _tileY1 > _tileY0)
+        {
+            _u8g2.updateDisplayArea(_tileX0, _tileY0, _tileX1 - _tileX0, _tileY1 - _tileY0);
+        }
+        _tileX0 = TILES_W;
+        _tileY0 = TILES_H;
+        _tileX1 = 0;
+        _tileY1 = 0;
+    }
+
+    U8G2 &u8g2() { return _u8g2; }
+
+private:
+    static constexpr uint8_t TILES_W = (84 + 7) / 8;
+    static constexpr uint8_t TILES_H = 48 / 8;
+
+    static uint8_t countTransfers(u8x8_t *u8x8, uint8_t msg, uint8_t arg, void *data)
+    {
+        if (msg == U8X8_MSG_BYTE_START_TRANSFER)
+        {
+            _transfers++;
+        }
+        return _byteCb(u8x8, msg, arg, data);
+    }
+
+    // one panel per build, and the callback has nowhere else to find them
+    static inline u8x8_msg_cb _byteCb = nullptr;
+    static inline uint32_t _transfers = 0;
+
+    U8g2Pcd8544 _u8g2;
+    uint8_t _tileX0 = TILES_W;
+    uint8_t _tileY0 = TILES_H;
+    uint8_t _tileX1 = 0;
+    uint8_t _tileY1 = 0;
+};
+
+#endif // DISPLAY_U8G2_H
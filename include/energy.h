@@ -0,0 +1,103 @@
+/**
+ * @file energy.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Heater and cleaner energy per cycle, and lifetime totals
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The relays time how long they are closed (Relay::onMicros(), and
+ * cleanerModOnMicros() for a pulsed cleaner).  The meter takes those totals
+ * when a cycle starts and ends; the difference, times the element's rating
+ * (HEATER_WATTS, CLEANER_WATTS - set them for the hardware), is the cycle's
+ * energy, and its share of the cycle's length is the duty.
+ *
+ * Lifetime totals are added up in RAM and copied to RTC user memory at the
+ * end of every cycle, so they survive a reset without touching flash.  They
+ * reach flash (saveSettings()) whenever settings are saved anyway, and on
+ * their own only once ENERGY_SAVE_WH has gone unsaved; a power cut loses at
+ * most that much.
+ */
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <Arduino.h>
+
+#ifndef HEATER_WATTS
+#define HEATER_WATTS 800 // per bath
+#endif
+#ifndef CLEANER_WATTS
+#define CLEANER_WATTS 60 // per bath, the transducer's average draw
+#endif
+#ifndef ENERGY_SAVE_WH
+#define ENERGY_SAVE_WH 1000
+#endif
+
+#define ENERGY_RTC_BLOCK 44 // after the resume checkpoint (resume.h)
+
+/// Wh for `us` of a `watts` load
+inline float energyWh(uint64_t us, uint16_t watts)
+{
+    return us * static_cast<float>(watts) / 3.6e9f;
+}
+
+/// One cycle, all baths together
+struct EnergyUse
+{
+    uint32_t runMs;
+    uint64_t heaterUs;
+    uint64_t cleanerUs;
+    uint8_t outputs; ///< baths, each with a heater and a cleaner
+
+    float heaterWh() const { return energyWh(heaterUs, HEATER_WATTS); }
+    float cleanerWh() const { return energyWh(cleanerUs, CLEANER_WATTS); }
+    uint8_t heaterDuty() const { return duty(heaterUs); }   ///< percent
+    uint8_t cleanerDuty() const { return duty(cleanerUs); } ///< percent
+
+private:
+    uint8_t duty(uint64_t onUs) const
+    {
+        uint64_t spanUs = static_cast<uint64_t>(runMs) * 1000 * outputs;
+        return spanUs ? static_cast<uint8_t>(min<uint64_t>(onUs * 100 / spanUs, 100)) : 0;
+    }
+};
+
+/// Kept in EEPROM by saveSettings()
+struct EnergyLifetime
+{
+    uint32_t cycles;
+    uint32_t runS;
+    uint64_t heaterUs;
+    uint64_t cleanerUs;
+
+    float wh() const { return energyWh(heaterUs, HEATER_WATTS) + energyWh(cleanerUs, CLEANER_WATTS); }
+};
+
+class EnergyMeter
+{
+public:
+    /// Start from the totals saved in EEPROM, or the RTC copy if it's newer
+    void begin(const EnergyLifetime &saved);
+
+    /// Cycle start and end, with the baths' on times summed
+    void startCycle(uint8_t outputs, uint64_t heaterUs, uint64_t cleanerUs);
+    void endCycle(uint64_t heaterUs, uint64_t cleanerUs);
+
+    const EnergyUse &lastCycle() const { return _cycle; }
+    const EnergyLifetime &lifetime() const { return _lifetime; }
+
+    /// More than ENERGY_SAVE_WH since the totals were last saved
+    bool saveDue() const { return _lifetime.wh() - _saved.wh() >= ENERGY_SAVE_WH; }
+
+    /// The totals have been written to EEPROM
+    void saved() { _saved = _lifetime; }
+
+private:
+    EnergyUse _cycle = {};
+    EnergyLifetime _lifetime = {};
+    EnergyLifetime _saved = {};
+    uint32_t _startMs = 0;
+};
+
+#endif // ENERGY_H
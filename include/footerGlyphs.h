@@ -15,7 +15,7 @@
 
 #define Temperature_width 26
 #define Temperature_height 32
-static unsigned char Temperature_data[] = {
+static const unsigned char Temperature_data[] PROGMEM = {
     0xe0, 0xff, 0x00, 0x00, 0xe0, 0xff, 0x60, 0x00, 0xe0, 0x7f, 0x60, 0x00,
     0x60, 0x18, 0x60, 0x00, 0x60, 0x1c, 0xfc, 0x02, 0x60, 0x18, 0xfc, 0x01,
     0x60, 0xfc, 0x60, 0x00, 0x60, 0xfc, 0x60, 0x00, 0x60, 0x58, 0x60, 0x00,
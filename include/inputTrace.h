@@ -0,0 +1,79 @@
+/**
+ * @file inputTrace.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Input trace recorder/replayer for input-to-display latency
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Built with -D INPUT_TRACE (env:trace).  Every encoder step, every change
+ * of the button's level and every frame that put something new on the
+ * panel goes into a ring of INPUT_TRACE_MAX events, newest kept.  Times are
+ * micros() since reset, so a trace covers about 71 minutes.
+ *
+ * inputTracePrint() writes the ring out as "TRACE ..." lines;
+ * scripts/trace_report.py turns a captured log into p50/p99 input-to-display
+ * latency per screen, and into a replay header for -D INPUT_REPLAY
+ * (env:trace_replay).  A replay build feeds the recorded button levels and
+ * encoder positions back in place of the hardware at the recorded times,
+ * and keeps tracing, so the two reports can be compared.
+ *
+ * The recorder is called from handleLoop(), which the Ticker also runs;
+ * Ticker callbacks never preempt loop() on the ESP8266, so no locking.
+ */
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <Arduino.h>
+
+#ifdef INPUT_REPLAY
+#ifndef INPUT_TRACE
+#define INPUT_TRACE // a replay is traced too
+#endif
+#endif
+
+#define INPUT_TRACE_MAX 256 // 8 bytes each
+
+enum InputEventKind : uint8_t
+{
+    INPUT_ENCODER = 'E', ///< value = new encoder position
+    INPUT_BUTTON = 'B',  ///< value = pin level (the button is active low)
+    INPUT_FRAME = 'F',   ///< value = frame time in us (saturates), us = when it finished
+};
+
+struct InputEvent
+{
+    uint32_t us;
+    uint16_t value;
+    uint8_t kind;
+    uint8_t screen; ///< screen on show (frames only)
+};
+
+void inputTraceEncoder(int16_t position);
+
+/// Call with every reading of the button pin; only changes are kept
+void inputTraceButton(uint8_t level);
+
+/// Call after every frame; only frames whose content changed are kept
+void inputTraceFrame(uint8_t screen, uint32_t startUs, uint32_t endUs, uint16_t hash);
+
+uint16_t inputTraceCount();
+uint32_t inputTraceDropped(); ///< overwritten because the ring was full
+const InputEvent &inputTraceEvent(uint16_t index); ///< 0 is the oldest
+void inputTraceClear();
+
+/// The ring as TRACE lines, with the screen names for the report
+void inputTracePrint(Print &out, const char *const screenNames[], uint8_t screens);
+
+/// Start replaying `count` input events (PROGMEM, from trace_report.py)
+void inputReplayBegin(const InputEvent *events, uint16_t count);
+bool inputReplaying();
+
+/// The button level the replay says the pin has now (advances the replay)
+uint8_t inputReplayButton();
+
+/// The encoder position the replay says we're at now (advances the replay)
+int16_t inputReplayPosition();
+
+#endif // INPUT_TRACE_H
@@ -0,0 +1,42 @@
+/**
+ * @file memStats.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Runtime heap and stack high-water tracking
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The build side of the memory budget is scripts/size_report.py; this is the
+ * runtime side.  memStatsSample() is cheap enough to call every pass through
+ * the loop - it only does real work once a second - and keeps the lowest
+ * free heap, the worst fragmentation and the stack high-water mark seen
+ * since boot.
+ */
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <Arduino.h>
+
+struct MemStats
+{
+    uint32_t freeHeap;        ///< bytes free now
+    uint32_t minFreeHeap;     ///< lowest free heap seen
+    uint32_t maxFreeBlock;    ///< largest single allocation possible now
+    uint8_t fragmentation;    ///< heap fragmentation now, percent
+    uint8_t maxFragmentation; ///< worst fragmentation seen, percent
+    uint32_t minFreeStack;    ///< loop stack never used (high-water mark)
+};
+
+/// Take a reading if a second has passed since the last one
+void memStatsSample();
+
+/// Take a reading now
+void memStatsUpdate();
+
+const MemStats &memStats();
+
+/// Human readable dump (Serial in debug builds)
+void memStatsPrint(Print &out);
+
+#endif // MEM_STATS_H
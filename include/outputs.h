@@ -0,0 +1,90 @@
+/**
+ * @file outputs.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Digital outputs on native GPIO or a PCF8574 I2C expander
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The ESP8266 runs out of free pins after one heater and one cleaner, so
+ * extra relays go on a PCF8574.  Its outputs are numbered on from the GPIOs:
+ * EXPANDER_PIN(0)..EXPANDER_PIN(7) are P0..P7.  outputPinMode() and
+ * outputWrite() take either kind, so code that drives a relay doesn't care
+ * where it is.  The expander keeps a copy of its port and only goes on the
+ * bus when a bit changes.
+ *
+ * The PCF8574 comes out of reset with every output high, so relay boards on
+ * it are expected to be active low (OUTPUT_EXPANDER_ACTIVE_LOW) - that way
+ * they stay off until we've written the port.  It uses the ESP8266's default
+ * I2C pins, GPIO4/GPIO5, which are the native heater and cleaner pins: a
+ * board with an expander has its relays on the expander.  The ESP8266 has
+ * one Wire bus, so with the I2C character panel the expander goes on the
+ * panel's pins (OUTPUT_EXPANDER_SDA/SCL) - main.cpp won't build otherwise.
+ *
+ * MODULATED_PIN(gpio) is a native GPIO whose "on" is the cleaner pattern
+ * from cleanerMod.h (pulsed, swept) instead of a steady high.
+ */
+#ifndef OUTPUTS_H
+#define OUTPUTS_H
+
+#include <Arduino.h>
+#include "cleanerMod.h"
+
+#define OUTPUT_EXPANDER_BASE 100
+#define EXPANDER_PIN(n) (OUTPUT_EXPANDER_BASE + (n))
+#define MODULATED_PIN_BASE 200
+#define MODULATED_PIN(gpio) (MODULATED_PIN_BASE + (gpio))
+
+#ifndef OUTPUT_EXPANDER_ADDRESS
+#define OUTPUT_EXPANDER_ADDRESS 0x20
+#endif
+#ifndef OUTPUT_EXPANDER_SDA
+#define OUTPUT_EXPANDER_SDA 4 // GPIO4, D2
+#endif
+#ifndef OUTPUT_EXPANDER_SCL
+#define OUTPUT_EXPANDER_SCL 5 // GPIO5, D1
+#endif
+#ifndef OUTPUT_EXPANDER_ACTIVE_LOW
+#define OUTPUT_EXPANDER_ACTIVE_LOW 1
+#endif
+
+void expanderPinMode(uint8_t bit);
+void expanderWrite(uint8_t bit, uint8_t level);
+
+/// I2C writes to the expander since boot (each one is ~0.2ms at 100kHz)
+uint32_t expanderWrites();
+
+inline void outputPinMode(uint8_t pin)
+{
+    if (pin >= MODULATED_PIN_BASE)
+    {
+        pinMode(pin - MODULATED_PIN_BASE, OUTPUT);
+    }
+    else if (pin >= OUTPUT_EXPANDER_BASE)
+    {
+        expanderPinMode(pin - OUTPUT_EXPANDER_BASE);
+    }
+    else
+    {
+        pinMode(pin, OUTPUT);
+    }
+}
+
+inline void outputWrite(uint8_t pin, uint8_t level)
+{
+    if (pin >= MODULATED_PIN_BASE)
+    {
+        cleanerModWrite(pin - MODULATED_PIN_BASE, level);
+    }
+    else if (pin >= OUTPUT_EXPANDER_BASE)
+    {
+        expanderWrite(pin - OUTPUT_EXPANDER_BASE, level);
+    }
+    else
+    {
+        digitalWrite(pin, level);
+    }
+}
+
+#endif // OUTPUTS_H
@@ -0,0 +1,94 @@
+/**
+ * @file postMortem.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief The last events before a reset, kept in RTC user memory
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * A ring of POSTMORTEM_EVENTS fixed-size events: the screens entered,
+ * the inputs, the relays switching and probes around the calls that can
+ * hang (flash writes, the bus scan).  Recording one is a single 8 byte
+ * write to RTC memory, with no read back and no index to update, so it
+ * costs the same every time and a watchdog can't catch it half way.
+ * Each event carries a sequence number; the newest is the one whose
+ * successor isn't next in sequence, and the run is followed back from
+ * there.  Slots that don't continue the run (a power cut, stale
+ * contents) are ignored.
+ *
+ * At boot postMortemBegin() copies what the ring holds, and the reset
+ * reason with the exception registers, to RAM for the "last_reset" page,
+ * then carries on recording after it.  A boot marker goes in first, so a
+ * reset loop shows up as several boots in a row.  Like the resume
+ * checkpoint, the ring survives a reset or a watchdog but not a loss of
+ * power.
+ */
+#ifndef POST_MORTEM_H
+#define POST_MORTEM_H
+
+#include <Arduino.h>
+
+#define POSTMORTEM_RTC_BLOCK 64 // after the energy totals (energy.h)
+#define POSTMORTEM_EVENTS 31    // 8 bytes each, after an 8 byte header: to the end of RTC user memory
+
+enum PostMortemKind : uint8_t
+{
+    PM_BOOT,    ///< arg = rst_reason
+    PM_STATE,   ///< arg = the UiState entered
+    PM_INPUT,   ///< arg = the UiEvent dispatched
+    PM_HEATER,  ///< arg = channel, POSTMORTEM_ON when it closed
+    PM_CLEANER, ///< arg = channel, POSTMORTEM_ON when it closed
+    PM_PROBE,   ///< arg = PostMortemProbe, on the way in
+};
+
+#define POSTMORTEM_ON 0x80
+
+enum PostMortemProbe : uint8_t
+{
+    PROBE_SENSOR_SCAN,
+    PROBE_LITTLEFS,
+    PROBE_EEPROM_COMMIT,
+    PROBE_HISTORY_ADD,
+};
+
+struct PostMortemEvent
+{
+    uint16_t seq; ///< 0 is an empty slot
+    uint8_t kind; ///< PostMortemKind
+    uint8_t arg;
+    uint32_t ms;  ///< millis()
+};
+
+/// Take the previous run's events and the reset reason, then record after them
+void postMortemBegin();
+
+/// Record an event
+void postMortemRecord(uint8_t kind, uint8_t arg);
+
+inline void postMortemProbe(PostMortemProbe probe)
+{
+    postMortemRecord(PM_PROBE, probe);
+}
+
+/// Names for PM_STATE and PM_INPUT events; without them they show as numbers
+void postMortemNames(const char *const states[], uint8_t stateCount, const char *const events[], uint8_t eventCount);
+
+/// The reset that started this run
+const rst_info &postMortemReset();
+const char *postMortemReason();
+
+/// The last reset was a watchdog or an exception
+bool postMortemCrashed();
+
+/// The events before this run's boot marker, as found at boot
+uint8_t postMortemCount();
+const PostMortemEvent &postMortemEvent(uint8_t index); ///< 0 is the oldest
+
+/// One event as text, "state timer", "heater 1 on"
+void postMortemDescribe(const PostMortemEvent &event, char *text, size_t size);
+
+/// The reset and the events as POSTMORTEM lines
+void postMortemPrint(Print &out);
+
+#endif // POST_MORTEM_H
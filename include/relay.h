@@ -0,0 +1,101 @@
+/**
+ * @file relay.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Relay actuation with minimum dwell, hysteresis and switch-rate limits
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Sits between the control decisions and the relay's output pin, which can
+ * be a GPIO or a pin on the I2C expander (see outputs.h).
+ * The control code asks for on or off every pass; the relay only follows
+ * when
+ *   - it has been in its current state for minOnMs / minOffMs, and
+ *   - the switch-rate budget (maxPerMinute, as a token bucket allowing a
+ *     burst of that many) has a switch left.
+ * Otherwise the request is held back and counted, and the next pass asks
+ * again.  requestBelow()/requestAbove() add a hysteresis band under the
+ * threshold, so a noisy reading sitting on the threshold can't chatter.
+ * forceOff() skips all of it - for safety, not control.
+ *
+ * requestExclusive() runs two relays one at a time, as the heater and the
+ * cleaner always have been: neither closes while the other is still on.
+ *
+ * Times are passed in (millis()), so the same code runs in the host
+ * benchmark, scripts/relay_bench.cpp.
+ *
+ * The relay also adds up how long it has been closed, for the energy
+ * accounting (energy.h).  That is timed with micros64() at each switch -
+ * one clock read and an add, nothing on the passes where it doesn't switch.
+ */
+#ifndef RELAY_H
+#define RELAY_H
+
+#include <Arduino.h>
+#include "outputs.h"
+
+struct RelayConfig
+{
+    uint32_t minOnMs;     ///< shortest on period
+    uint32_t minOffMs;    ///< shortest off period
+    float hysteresis;     ///< band below the threshold, same units as the reading
+    uint8_t maxPerMinute; ///< switch operations per minute, 0 for no limit
+};
+
+class Relay
+{
+public:
+    /// @param pin a GPIO or EXPANDER_PIN(n)
+    Relay(uint8_t pin, const RelayConfig &config);
+
+    /// Drive the pin low (off); call first thing in setup()
+    void begin();
+
+    /// Ask for a state; returns the state the relay is in afterwards
+    bool request(bool on, uint32_t nowMs);
+
+    /// On below threshold - hysteresis, off at threshold, no change between
+    bool requestBelow(float value, float threshold, uint32_t nowMs);
+
+    /// On at threshold, off below threshold - hysteresis, no change between
+    bool requestAbove(float value, float threshold, uint32_t nowMs);
+
+    /// What requestBelow() / requestAbove() would ask for, without asking
+    bool wantBelow(float value, float threshold) const;
+    bool wantAbove(float value, float threshold) const;
+
+    /// Off now, whatever the dwell and rate limits say
+    void forceOff(uint32_t nowMs);
+
+    bool isOn() const { return _on; }
+    uint32_t switches() const { return _switches; } ///< switch operations since boot
+    uint32_t held() const { return _held; }         ///< requests held back by dwell or rate
+    const RelayConfig &config() const { return _config; }
+    uint8_t pin() const { return _pin; }
+
+    /// Time spent closed since boot, including the current on period
+    uint64_t onMicros() const;
+
+private:
+    void apply(bool on, uint32_t nowMs);
+
+    uint8_t _pin;
+    RelayConfig _config;
+    bool _on = false;
+    uint32_t _changedMs = 0; // last switch
+    uint32_t _creditMs = 0;  // rate budget, one switch costs 60000 / maxPerMinute
+    uint32_t _creditAtMs = 0;
+    uint32_t _switches = 0;
+    uint32_t _held = 0;
+    uint64_t _onUs = 0;      // closed time, up to the last switch
+    uint64_t _onSinceUs = 0; // the last switch
+};
+
+/// Ask for `firstOn` and `secondOn`, never both on together.  `first`
+/// wins: the second is asked off, and the first only closes once it has
+/// opened (its dwell can hold that back); the second only closes with the
+/// first open.
+void requestExclusive(Relay &first, bool firstOn, Relay &second, bool secondOn, uint32_t nowMs);
+
+#endif // RELAY_H
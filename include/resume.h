@@ -0,0 +1,65 @@
+/**
+ * @file resume.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Checkpoint of the running cycle in RTC user memory, for resuming after a reset
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * While a cycle runs the timer page writes a checkpoint once a second: the
+ * settings it was started with and, per bath, the time left, the phase and
+ * the relay states.  It goes to the ESP8266's RTC user memory - no flash
+ * wear, no flash stall, a few microseconds - guarded by a magic number and
+ * a CRC32, and is cleared when the cycle ends.
+ *
+ * RTC memory keeps its contents through a reset, a watchdog and a brown-out
+ * that resets the chip, but not through a complete loss of power; then (or
+ * after any corruption) the CRC fails and there's nothing to resume.
+ * The first 128 bytes of RTC user memory are left for OTA (eboot), so the
+ * checkpoint lives from RESUME_RTC_BLOCK on.
+ */
+#ifndef RESUME_H
+#define RESUME_H
+
+#include <Arduino.h>
+
+#define RESUME_RTC_BLOCK 32 // 4 byte blocks; 0..31 belong to OTA
+#define RESUME_MAX_CHANNELS 4
+
+struct ResumeChannel
+{
+    uint32_t remainingMs;
+    uint8_t phase; ///< BathPhase
+    uint8_t heaterOn;
+    uint8_t cleanerOn;
+    uint8_t reserved;
+};
+
+struct ResumeCheckpoint
+{
+    uint32_t magic;
+    uint8_t setTemperatureF;
+    uint8_t timerMinutes; ///< what the cycle was started with
+    uint8_t channels;
+    uint8_t reserved;
+    ResumeChannel channel[RESUME_MAX_CHANNELS];
+    uint32_t crc; ///< CRC32 of everything above
+};
+
+/// Store a checkpoint (fills in magic and crc)
+void resumeSave(ResumeCheckpoint &checkpoint);
+
+/// Read the checkpoint back; false if there isn't a valid one
+bool resumeLoad(ResumeCheckpoint &checkpoint);
+
+/// Forget the checkpoint: the cycle ended (or the user declined it)
+void resumeClear();
+
+/// How long the last resumeSave() took
+uint32_t resumeSaveMicros();
+
+/// The CRC32 guarding the checkpoint, for other records kept in RTC memory
+uint32_t rtcCrc32(const void *record, size_t length);
+
+#endif // RESUME_H
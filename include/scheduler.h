@@ -0,0 +1,88 @@
+/**
+ * @file scheduler.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Round robin updates inside a fixed time budget per loop pass
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Every pass through a page's loop has the encoder, the button and a frame
+ * to look after as well as the baths, so the baths get a budget.  run()
+ * updates tasks in turn, carrying on from where the last pass stopped,
+ * until the budget is spent or every task has had a turn.  At least one
+ * task runs every pass, so no task waits more than `count` passes however
+ * slow the others are - and the scheduler keeps the worst wait it has seen
+ * so that bound can be checked (scripts/channel_sim.cpp does it on a PC).
+ *
+ * A task is anything with an update() method.
+ */
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+#define SCHEDULER_MAX_TASKS 8
+
+class Scheduler
+{
+public:
+    explicit Scheduler(uint32_t budgetUs) : _budgetUs(budgetUs) {}
+
+    /// Update some of `tasks`; returns how many ran
+    template <class Task>
+    uint8_t run(Task *tasks, uint8_t count)
+    {
+        uint32_t start = micros();
+        uint8_t ran = 0;
+        while (ran < count)
+        {
+            uint8_t i = _next < count ? _next : 0;
+            _next = (i + 1) % count;
+
+            uint32_t now = micros();
+            if (_seen & (1 << i))
+            {
+                _maxWaitUs = max(_maxWaitUs, now - _lastUs[i]);
+            }
+            _seen |= 1 << i;
+            _lastUs[i] = now;
+
+            tasks[i].update();
+            ran++;
+            if (micros() - start >= _budgetUs)
+            {
+                break;
+            }
+        }
+        _passUs = micros() - start;
+        if (_passUs > _budgetUs)
+        {
+            _overruns++;
+        }
+        return ran;
+    }
+
+    uint32_t budgetUs() const { return _budgetUs; }
+    uint32_t passUs() const { return _passUs; }       ///< time the last run() took
+    uint32_t maxWaitUs() const { return _maxWaitUs; } ///< longest any task went between updates
+    uint32_t overruns() const { return _overruns; }   ///< passes that went over the budget
+
+    void resetStats()
+    {
+        _maxWaitUs = 0;
+        _overruns = 0;
+        _seen = 0;
+    }
+
+private:
+    uint32_t _budgetUs;
+    uint32_t _lastUs[SCHEDULER_MAX_TASKS] = {};
+    uint32_t _passUs = 0;
+    uint32_t _maxWaitUs = 0;
+    uint32_t _overruns = 0;
+    uint8_t _seen = 0; // bit per task: has run at least once
+    uint8_t _next = 0;
+};
+
+#endif // SCHEDULER_H
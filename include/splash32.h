@@ -1,116 +0,0 @@
-/**
- * @file    splash32.h
- *
- *
- * @brief   128x32 splash screen 'Arduino: Inside'
- *          This file generated from img2cpp on github
- *
- * Splashes will be stored in PROGMEM (flash).
- */
-
-/* clang-format off */
-
-// 'splash1', 128x32px
-#define splash1_width 128
-#define splash1_height 32
-const unsigned char splash1_bits[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0x03, 0x00, 0xf0, 0x7f, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0x0f,
-   0x00, 0xfc, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0xf0, 0xff, 0x3f, 0x00, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x7f, 0x80, 0xff, 0xff, 0x0f,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x83, 0xff,
-   0xc0, 0x7f, 0xf0, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0xfe, 0x00, 0xfc, 0xe1, 0x0f, 0xc0, 0x1f, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x3e, 0x00, 0xf8, 0xf3, 0x07, 0x00, 0x3f,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0xe0,
-   0xf7, 0x03, 0x00, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x1f, 0x00, 0xe0, 0xff, 0x01, 0x00, 0x7c, 0x20, 0x38, 0x38, 0x08,
-   0xf9, 0x08, 0x61, 0x00, 0x80, 0x0f, 0x00, 0xc0, 0xff, 0x00, 0x03, 0x7c,
-   0x70, 0xfc, 0xfc, 0x8c, 0xf9, 0x9d, 0xf9, 0x00, 0x80, 0x0f, 0x00, 0x80,
-   0x7f, 0x00, 0x03, 0x7c, 0xf0, 0xcc, 0xcd, 0x8d, 0x61, 0x9c, 0x9d, 0x01,
-   0x80, 0x0f, 0xfe, 0x01, 0x7f, 0xe0, 0x1f, 0x78, 0xd8, 0x8c, 0x8d, 0x8d,
-   0x61, 0xbc, 0x8d, 0x01, 0x80, 0x0f, 0xff, 0x03, 0x3f, 0xe0, 0x1f, 0x78,
-   0xd8, 0xfc, 0x8c, 0x8d, 0x61, 0xbc, 0x8d, 0x01, 0x80, 0x0f, 0x00, 0x00,
-   0x3f, 0xe0, 0x1f, 0x78, 0xd8, 0x7c, 0x8c, 0x8d, 0x61, 0xec, 0x8d, 0x01,
-   0x80, 0x0f, 0x00, 0x80, 0x7f, 0x00, 0x03, 0x7c, 0xfc, 0xcd, 0x8c, 0x8d,
-   0x61, 0xec, 0x8d, 0x01, 0x80, 0x0f, 0x00, 0x80, 0xff, 0x00, 0x03, 0x7c,
-   0xfc, 0xcd, 0xcc, 0x8d, 0x61, 0xcc, 0x8d, 0x01, 0x80, 0x0f, 0x00, 0xc0,
-   0xff, 0x00, 0x00, 0x7c, 0x8c, 0x8d, 0xfd, 0xf8, 0xf8, 0xcd, 0xf9, 0x00,
-   0x00, 0x1f, 0x00, 0xe0, 0xff, 0x01, 0x00, 0x7e, 0x04, 0x09, 0x19, 0x70,
-   0xf8, 0x80, 0x71, 0x00, 0x00, 0x3f, 0x00, 0xf0, 0xf3, 0x03, 0x00, 0x3f,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7e, 0x00, 0xf8,
-   0xe1, 0x07, 0x80, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0xfe, 0x01, 0xfe, 0xc1, 0x1f, 0xe0, 0x1f, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0xff, 0x80, 0xff, 0xff, 0x0f,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x7f,
-   0x00, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0xe0, 0xff, 0x1f, 0x00, 0xfe, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0x0f, 0x00, 0xf8, 0xff, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x01,
-   0x00, 0xe0, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-
-// 'splash2', 128x32px
-#define splash2_width 128
-#define splash2_height 32
-const unsigned char splash2_bits[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x30, 0x00, 0x00, 0x00, 0x80, 0xff, 0x03, 0x00, 0xf0, 0x7f, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0xe0, 0xff, 0x0f,
-   0x00, 0xfc, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00,
-   0x00, 0xf0, 0xff, 0x3f, 0x00, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x18, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x7f, 0x80, 0xff, 0xff, 0x0f,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0xfc, 0x83, 0xff,
-   0xc0, 0x7f, 0xf0, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x04, 0x18, 0x3c, 0x00,
-   0x00, 0xfe, 0x00, 0xfc, 0xe1, 0x0f, 0xc0, 0x1f, 0x00, 0x00, 0x00, 0x00,
-   0x06, 0x0c, 0x16, 0x00, 0x00, 0x3e, 0x00, 0xf8, 0xf3, 0x07, 0x00, 0x3f,
-   0x80, 0x07, 0x00, 0x00, 0x82, 0x0f, 0x1b, 0x00, 0x00, 0x1f, 0x00, 0xe0,
-   0xf7, 0x03, 0x00, 0x3e, 0xc0, 0x07, 0x00, 0x00, 0xc0, 0x0f, 0x0b, 0x00,
-   0x00, 0x1f, 0x00, 0xe0, 0xff, 0x01, 0x00, 0x7c, 0xe0, 0x04, 0x00, 0x04,
-   0xc2, 0x8d, 0x07, 0x00, 0x80, 0x0f, 0x00, 0xc0, 0xff, 0x00, 0x03, 0x7c,
-   0x70, 0x0c, 0x00, 0x0c, 0x63, 0x8e, 0x43, 0x00, 0x80, 0x0f, 0x00, 0x80,
-   0x7f, 0x00, 0x03, 0x7c, 0x30, 0x0c, 0x00, 0x8e, 0x33, 0xce, 0x23, 0x00,
-   0x80, 0x0f, 0xfe, 0x01, 0x7f, 0xe0, 0x1f, 0x78, 0x38, 0x04, 0x18, 0x8e,
-   0x31, 0x6d, 0x1f, 0x00, 0x80, 0x0f, 0xff, 0x03, 0x3f, 0xe0, 0x1f, 0x78,
-   0x18, 0x04, 0x1c, 0xdd, 0xb1, 0x3d, 0x1f, 0x00, 0x80, 0x0f, 0x00, 0x00,
-   0x3f, 0xe0, 0x1f, 0x78, 0x1c, 0x84, 0x1c, 0xc9, 0xf8, 0x18, 0x06, 0x00,
-   0x80, 0x0f, 0x00, 0x80, 0x7f, 0x00, 0x03, 0x7c, 0x1c, 0xc6, 0x8e, 0xc8,
-   0xec, 0x08, 0x00, 0x00, 0x80, 0x0f, 0x00, 0x80, 0xff, 0x00, 0x03, 0x7c,
-   0x3c, 0x66, 0xcf, 0xac, 0x07, 0x00, 0x00, 0x00, 0x80, 0x0f, 0x00, 0xc0,
-   0xff, 0x00, 0x00, 0x7c, 0x18, 0x66, 0xe5, 0x97, 0x07, 0x00, 0x00, 0x00,
-   0x00, 0x1f, 0x00, 0xe0, 0xff, 0x01, 0x00, 0x7e, 0x00, 0xe2, 0xad, 0x1f,
-   0x01, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x00, 0xf0, 0xf3, 0x03, 0x00, 0x3f,
-   0x00, 0xe2, 0x1c, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7e, 0x00, 0xf8,
-   0xe1, 0x07, 0x80, 0x3f, 0x00, 0xe3, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0xfe, 0x01, 0xfe, 0xc1, 0x1f, 0xe0, 0x1f, 0x00, 0x41, 0x04, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0xff, 0x80, 0xff, 0xff, 0x0f,
-   0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x7f,
-   0x00, 0xff, 0xff, 0x07, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0xe0, 0xff, 0x1f, 0x00, 0xfe, 0xff, 0x03, 0x80, 0x01, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0x0f, 0x00, 0xf8, 0xff, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x01,
-   0x00, 0xe0, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-
-// Array of all bitmaps for convenience. (Total bytes used to store images in PROGMEM = 3136)
-const int allArray_LEN = 2;
-const unsigned char* allArray[2] = {
-	splash1_bits,
-	splash2_bits
-};
-/* clang-format on */
-// #endif
@@ -1,207 +0,0 @@
-/**
- * @file    splash64.h
- *
- *
- * @brief   128x64 splash screen 'Arduino: Inside'
- *          This file generated from img2cpp on github
- *
- * Splashes will be stored in PROGMEM (flash).
- */
-
-/* clang-format off */
-
-// 'splash1', 128x64px
-#define splash1_width 128
-#define splash1_height 64
-
-const unsigned char splash1_bits [] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x7f, 0x00, 0x00,
-   0x00, 0x00, 0xfe, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0xf0, 0xff, 0x07, 0x00, 0x00, 0xe0, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0x1f, 0x00, 0x00, 0xf8, 0xff, 0x3f,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x7f, 0x00,
-   0x00, 0xfe, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
-   0xff, 0xff, 0xff, 0x01, 0x00, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xc0, 0xff, 0xff, 0xff, 0x03, 0xc0, 0xff, 0xff, 0xff,
-   0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0xff, 0xff, 0x07,
-   0xe0, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0,
-   0xff, 0x80, 0xff, 0x0f, 0xf0, 0xff, 0x01, 0xfe, 0x0f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xf8, 0x1f, 0x00, 0xfc, 0x1f, 0xf8, 0x3f, 0x00, 0xf8,
-   0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x07, 0x00, 0xf0, 0x3f,
-   0xfc, 0x0f, 0x00, 0xe0, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc,
-   0x03, 0x00, 0xe0, 0x3f, 0xfc, 0x07, 0x00, 0xc0, 0x3f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xfe, 0x01, 0x00, 0xc0, 0x7f, 0xfe, 0x03, 0x00, 0x80,
-   0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x00, 0x00, 0x80, 0xff,
-   0xff, 0x01, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
-   0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x3c, 0x00, 0xff, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0xfe, 0x7f, 0x00, 0x3c, 0x00,
-   0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0xfc,
-   0x3f, 0x00, 0x3c, 0x00, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
-   0x00, 0x00, 0x00, 0xfc, 0x3f, 0x00, 0x3e, 0x00, 0xfc, 0x01, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x7f, 0xe0, 0xff, 0x03, 0xf8, 0x1f, 0x80, 0xff, 0x01,
-   0xfc, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xe0, 0xff, 0x07, 0xf0,
-   0x1f, 0xc0, 0xff, 0x01, 0xfc, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f,
-   0xe0, 0xff, 0x03, 0xf0, 0x1f, 0xc0, 0xff, 0x01, 0xfc, 0x01, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0xf8, 0x1f, 0x80, 0xff, 0x00,
-   0xfc, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0xf8,
-   0x3f, 0x00, 0x3c, 0x00, 0xfc, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
-   0x00, 0x00, 0x00, 0xfc, 0x3f, 0x00, 0x3c, 0x00, 0xfe, 0x01, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0xfe, 0x7f, 0x00, 0x3c, 0x00,
-   0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0xff,
-   0xff, 0x00, 0x00, 0x00, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe,
-   0x00, 0x00, 0x00, 0xff, 0xff, 0x01, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xfe, 0x01, 0x00, 0x80, 0x7f, 0xfe, 0x01, 0x00, 0x80,
-   0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x03, 0x00, 0xc0, 0x7f,
-   0xfc, 0x03, 0x00, 0x80, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc,
-   0x07, 0x00, 0xe0, 0x3f, 0xfc, 0x07, 0x00, 0xc0, 0x3f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xf8, 0x0f, 0x00, 0xf8, 0x1f, 0xf8, 0x1f, 0x00, 0xf0,
-   0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x3f, 0x00, 0xfc, 0x0f,
-   0xf0, 0x3f, 0x00, 0xfc, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0,
-   0xff, 0xc1, 0xff, 0x07, 0xe0, 0xff, 0x83, 0xff, 0x0f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xe0, 0xff, 0xff, 0xff, 0x03, 0xc0, 0xff, 0xff, 0xff,
-   0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0xff, 0xff, 0x01,
-   0x80, 0xff, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
-   0xff, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0x7f, 0x00, 0x00, 0xfc, 0xff, 0x7f,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x1f, 0x00,
-   0x00, 0xf8, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0xe0, 0xff, 0x03, 0x00, 0x00, 0xc0, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0xf0, 0x87, 0x3f, 0x18,
-   0x8c, 0x7f, 0x1c, 0x06, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8,
-   0xf0, 0x8f, 0xff, 0x18, 0x9c, 0x7f, 0x3c, 0xce, 0x3f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xf8, 0x70, 0x9e, 0xf3, 0x19, 0x1c, 0x1e, 0x3c, 0xce,
-   0x79, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x70, 0x9c, 0xc3, 0x19,
-   0x1c, 0x1c, 0x7c, 0xee, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc,
-   0x70, 0x9c, 0xc3, 0x19, 0x1c, 0x1c, 0x7c, 0xee, 0xf0, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xdc, 0xf1, 0x9e, 0x83, 0x19, 0x1c, 0x1c, 0xfc, 0xee,
-   0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcc, 0xf1, 0x8f, 0x83, 0x19,
-   0x1c, 0x1c, 0xfc, 0xee, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce,
-   0xf1, 0x87, 0x83, 0x19, 0x1c, 0x1c, 0xcc, 0xee, 0xe0, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xce, 0xf3, 0x8f, 0xc3, 0x19, 0x1c, 0x1c, 0xcc, 0xef,
-   0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x73, 0x8e, 0xc3, 0x19,
-   0x1c, 0x1c, 0x8c, 0xef, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
-   0x73, 0x9c, 0xc3, 0x39, 0x0c, 0x1c, 0x8c, 0xef, 0x70, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x87, 0x73, 0x9c, 0xf7, 0x38, 0x0e, 0x1e, 0x8c, 0xcf,
-   0x7b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x77, 0x9c, 0x7f, 0xf0,
-   0x8f, 0x7f, 0x0c, 0xcf, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
-   0x33, 0x18, 0x1f, 0xe0, 0x83, 0x7f, 0x0c, 0x07, 0x1f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00 };
-
-// 'splash2', 128x64px
-#define splash2_width 128
-#define splash2_height 64
-
-const unsigned char splash2_bits[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x7f, 0x00, 0x00,
-   0x00, 0x00, 0xfe, 0x01, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0xf0, 0xff, 0x07, 0x00, 0x00, 0xe0, 0xff, 0x0f, 0x0f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0x1f, 0x00, 0x00, 0x80, 0xff, 0x8f,
-   0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x7f, 0x00,
-   0x00, 0x00, 0xff, 0x87, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c,
-   0xf8, 0xff, 0xff, 0x01, 0x00, 0x00, 0xfe, 0xc7, 0x07, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xff, 0xf0, 0xff, 0xff, 0x03, 0x40, 0x00, 0xfc, 0xc3,
-   0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xf0, 0xff, 0xff, 0x07,
-   0x60, 0x38, 0xfc, 0xc1, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff,
-   0xf1, 0x80, 0xff, 0x0f, 0x70, 0x3c, 0x00, 0xe0, 0x01, 0xe0, 0x00, 0x00,
-   0x00, 0x00, 0xf0, 0xff, 0x11, 0x00, 0xfc, 0x1f, 0x38, 0x3c, 0x00, 0xe0,
-   0x01, 0xf8, 0x01, 0x00, 0x00, 0x00, 0xf8, 0xc3, 0x01, 0x00, 0xf0, 0x03,
-   0x3c, 0x3c, 0x00, 0xe0, 0x00, 0xfc, 0x01, 0x00, 0x00, 0x00, 0xfc, 0xc1,
-   0x01, 0x00, 0xe0, 0x01, 0x3c, 0x1c, 0x00, 0xf0, 0x00, 0xde, 0x01, 0x00,
-   0x00, 0x00, 0xfc, 0xc0, 0x01, 0x00, 0xc0, 0x00, 0x3c, 0x00, 0x00, 0xf7,
-   0x00, 0xc7, 0x01, 0x00, 0x00, 0x00, 0x7e, 0xc0, 0x01, 0x00, 0x80, 0x30,
-   0x1c, 0x00, 0xc0, 0x7f, 0x80, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xc0,
-   0x00, 0x00, 0x00, 0x38, 0x0c, 0x06, 0xf0, 0x7f, 0xc0, 0xe3, 0x00, 0x00,
-   0x00, 0x00, 0x1f, 0xe0, 0x00, 0x00, 0x00, 0x78, 0x00, 0x07, 0xf8, 0x3f,
-   0xe0, 0x71, 0x00, 0x00, 0x00, 0x80, 0x0f, 0xe0, 0x00, 0x00, 0x00, 0x7c,
-   0x80, 0x07, 0xfc, 0x39, 0xe0, 0x39, 0x00, 0x00, 0x00, 0x80, 0x0f, 0xe0,
-   0x00, 0x00, 0x00, 0xfc, 0xc0, 0x07, 0xfe, 0x38, 0xf0, 0x0d, 0x00, 0x00,
-   0x00, 0xc0, 0x07, 0xf0, 0x00, 0x80, 0x01, 0xfe, 0xe0, 0x07, 0x7e, 0x1c,
-   0xf0, 0x07, 0x00, 0x00, 0x00, 0xc0, 0x07, 0x70, 0x00, 0xc0, 0x03, 0xfe,
-   0xe0, 0x03, 0x1f, 0x1e, 0xf0, 0x03, 0x06, 0x00, 0x00, 0xc0, 0x03, 0x70,
-   0x00, 0xe0, 0x03, 0xfb, 0xf0, 0x81, 0x0f, 0x1e, 0xf0, 0x01, 0x03, 0x00,
-   0x00, 0xe0, 0x17, 0x70, 0xe0, 0xf1, 0x83, 0xf1, 0xf0, 0x81, 0x07, 0x1f,
-   0xf8, 0x80, 0x01, 0x00, 0x00, 0xc0, 0x0f, 0x78, 0xe0, 0xf9, 0x83, 0xf1,
-   0xf8, 0x80, 0x87, 0x1f, 0xfc, 0xc1, 0x01, 0x00, 0x00, 0xc0, 0x0f, 0x38,
-   0xf0, 0xfc, 0xc1, 0xf0, 0x78, 0x80, 0xc7, 0x1d, 0xfe, 0xf3, 0x00, 0x00,
-   0x00, 0x00, 0x03, 0x38, 0x78, 0xfc, 0x60, 0x70, 0x78, 0xc0, 0xe7, 0x3c,
-   0xf7, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x78, 0xee, 0x30, 0x70,
-   0x7c, 0xe0, 0xf7, 0xfc, 0xe3, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c,
-   0x3c, 0x77, 0x30, 0x30, 0xfe, 0x38, 0x7f, 0xfc, 0xc1, 0x1f, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x1e, 0x3c, 0x73, 0xf8, 0x18, 0xff, 0x1f, 0x3f, 0xf8,
-   0x81, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x9e, 0x33, 0xfc, 0x9f,
-   0xfb, 0x1f, 0x1e, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e,
-   0xde, 0x39, 0xfe, 0xff, 0xf1, 0x0f, 0x0c, 0x30, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x07, 0xfe, 0x38, 0xff, 0xff, 0xe0, 0x07, 0x00, 0x00,
-   0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xfe, 0xf8, 0xe3, 0x7f,
-   0xc0, 0x03, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
-   0x7c, 0xfc, 0xc1, 0x1f, 0x00, 0xc0, 0x80, 0x03, 0x0f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x80, 0x03, 0x7c, 0xfc, 0x80, 0x0f, 0x00, 0xe0, 0xe3, 0xff,
-   0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x03, 0x38, 0x7c, 0x00, 0x00,
-   0x00, 0xf0, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x03,
-   0x18, 0x38, 0x00, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0xc0, 0x03, 0x00, 0x00, 0x1c, 0x00, 0x00, 0xfc, 0xff, 0x7f,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0x00, 0x1e, 0x00,
-   0x00, 0xf8, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x01,
-   0x80, 0x01, 0x03, 0x00, 0x00, 0xc0, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0xf0, 0x87, 0x3f, 0x18,
-   0x8c, 0x7f, 0x1c, 0x06, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8,
-   0xf0, 0x8f, 0xff, 0x18, 0x9c, 0x7f, 0x3c, 0xce, 0x3f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xf8, 0x70, 0x9e, 0xf3, 0x19, 0x1c, 0x1e, 0x3c, 0xce,
-   0x79, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x70, 0x9c, 0xc3, 0x19,
-   0x1c, 0x1c, 0x7c, 0xee, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc,
-   0x70, 0x9c, 0xc3, 0x19, 0x1c, 0x1c, 0x7c, 0xee, 0xf0, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xdc, 0xf1, 0x9e, 0x83, 0x19, 0x1c, 0x1c, 0xfc, 0xee,
-   0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcc, 0xf1, 0x8f, 0x83, 0x19,
-   0x1c, 0x1c, 0xfc, 0xee, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce,
-   0xf1, 0x87, 0x83, 0x19, 0x1c, 0x1c, 0xcc, 0xee, 0xe0, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0xce, 0xf3, 0x8f, 0xc3, 0x19, 0x1c, 0x1c, 0xcc, 0xef,
-   0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x73, 0x8e, 0xc3, 0x19,
-   0x1c, 0x1c, 0x8c, 0xef, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
-   0x73, 0x9c, 0xc3, 0x39, 0x0c, 0x1c, 0x8c, 0xef, 0x70, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x87, 0x73, 0x9c, 0xf7, 0x38, 0x0e, 0x1e, 0x8c, 0xcf,
-   0x7b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x77, 0x9c, 0x7f, 0xf0,
-   0x8f, 0x7f, 0x0c, 0xcf, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
-   0x33, 0x18, 0x1f, 0xe0, 0x83, 0x7f, 0x0c, 0x07, 0x1f, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00 };
-
-
-
-// Array of all bitmaps for convenience. (Total bytes used to store images in PROGMEM = 3136)
-const int allArray_LEN = 2;
-const unsigned char* allArray[2] = {
-	splash1_bits,
-	splash2_bits
-};
-/* clang-format on */
-// #endif
-// approx 16Kb
\ No newline at end of file
@@ -0,0 +1,369 @@
+/**
+ * @file stateMachine.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Table-driven hierarchical state machine
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The states and transitions are constexpr tables.  Each state names its
+ * parent, and a transition is (from, event, to, action, guard).  A state
+ * handles an event when it or one of its ancestors has a transition for it.
+ * The nearest one wins, so a rule such as "any press goes back" is written
+ * once, on the parent.  StateChart's constructor resolves this at compile
+ * time into a state x event table, so dispatch is a single lookup.
+ * Transitions that share a state and event sit next to each other in the
+ * list and are tried in order, with their guards.
+ *
+ * Taking a transition runs its action first, while the source is still
+ * current, so the action can commit what the source state was editing
+ * before that state's exit action (a save, say) sees it.  It then exits
+ * every state below the one both ends share, and enters the states down
+ * to the target:
+ *   - to = NO_STATE is internal: only the action runs, nothing exits
+ *   - to = the current state exits it and enters it again
+ *   - to = an ancestor exits down to it, but doesn't enter it again
+ * A state with a timeout gets the chart's timeout event once it has been
+ * current for that long.
+ *
+ * Nothing blocks.  The owner calls dispatch() with each input event, and
+ * run() once per loop pass.  run() calls the current state's run action,
+ * then dispatches anything that action post()ed.  StateChart::dump()
+ * writes the graph in Graphviz dot.
+ */
+#ifndef STATE_MACHINE_H
+#define STATE_MACHINE_H
+
+#include <Arduino.h>
+
+#define NO_STATE 0xFF
+#define NO_EVENT 0xFF
+#define STATE_DEPTH_MAX 8
+
+struct StateDef
+{
+    uint8_t parent;           ///< NO_STATE at the top
+    const char *name;
+    void (*enter)() = nullptr;
+    void (*exit)() = nullptr;
+    void (*run)() = nullptr;  ///< every pass while current
+    uint32_t timeoutMs = 0;   ///< 0 for none
+};
+
+struct Guard
+{
+    bool (*test)(uint8_t arg);
+    const char *name; ///< for dump()
+};
+
+struct Transition
+{
+    uint8_t from;
+    uint8_t event;
+    uint8_t to;                  ///< NO_STATE for an internal transition
+    void (*action)() = nullptr;
+    const Guard *guard = nullptr; ///< nullptr: always taken
+    uint8_t arg = 0;             ///< passed to the guard
+};
+
+// Not constexpr: reaching one while a chart is built is a compile error
+void stateChartParentAfterChild();
+void stateChartTooDeep();
+void stateChartTransitionsApart();
+void stateChartTooManyTransitions();
+
+template <uint8_t STATES, uint8_t EVENTS>
+struct StateChart
+{
+    static constexpr uint8_t NONE = 0xFF;
+    static constexpr uint8_t STATE_COUNT = STATES;
+    static constexpr uint8_t EVENT_COUNT = EVENTS;
+
+    template <size_t TRANSITIONS>
+    constexpr StateChart(const StateDef (&stateDefs)[STATES], const Transition (&transitionDefs)[TRANSITIONS],
+                         const char *const (&eventNameList)[EVENTS], uint8_t timeout)
+        : states(stateDefs), transitions(transitionDefs), transitionCount(TRANSITIONS),
+          eventNames(eventNameList), timeoutEvent(timeout), first{}
+    {
+        if (TRANSITIONS >= NONE)
+        {
+            stateChartTooManyTransitions();
+        }
+        for (uint8_t s = 0; s < STATES; s++)
+        {
+            // parents first means there can be no loops
+            if (states[s].parent != NO_STATE && states[s].parent >= s)
+            {
+                stateChartParentAfterChild();
+            }
+            if (depth(s) > STATE_DEPTH_MAX)
+            {
+                stateChartTooDeep();
+            }
+        }
+        for (uint8_t i = 0; i < TRANSITIONS; i++)
+        {
+            for (uint8_t j = i + 2; j < TRANSITIONS; j++)
+            {
+                if (same(i, j) && !same(i, j - 1))
+                {
+                    stateChartTransitionsApart();
+                }
+            }
+        }
+
+        for (uint8_t s = 0; s < STATES; s++)
+        {
+            for (uint8_t e = 0; e < EVENTS; e++)
+            {
+                first[s][e] = NONE;
+                for (uint8_t a = s; a != NO_STATE && first[s][e] == NONE; a = states[a].parent)
+                {
+                    for (uint8_t i = 0; i < TRANSITIONS; i++)
+                    {
+                        if (transitions[i].from == a && transitions[i].event == e)
+                        {
+                            first[s][e] = i;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// Levels from the top, 1 for a top level state
+    constexpr uint8_t depth(uint8_t state) const
+    {
+        uint8_t levels = 0;
+        for (; state != NO_STATE && levels <= STATE_DEPTH_MAX; state = states[state].parent)
+        {
+            levels++;
+        }
+        return levels;
+    }
+
+    /// `ancestor` is `state` or one of its parents
+    constexpr bool contains(uint8_t ancestor, uint8_t state) const
+    {
+        for (; state != NO_STATE; state = states[state].parent)
+        {
+            if (state == ancestor)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Graphviz dot: the hierarchy as dotted lines, and the transitions
+    /// labelled "event [guard arg]".  Internal transitions loop back.
+    template <class Out>
+    void dump(Out &out, const char *graph = "states") const
+    {
+        out.print("digraph ");
+        out.print(graph);
+        out.print(" {\n");
+        for (uint8_t s = 0; s < STATES; s++)
+        {
+            if (states[s].parent != NO_STATE)
+            {
+                edge(out, states[s].parent, s);
+                out.print(" [style=dotted, arrowhead=none];\n");
+            }
+        }
+        for (uint8_t i = 0; i < transitionCount; i++)
+        {
+            const Transition &t = transitions[i];
+            edge(out, t.from, t.to == NO_STATE ? t.from : t.to);
+            out.print(" [label=\"");
+            out.print(eventNames[t.event]);
+            if (t.guard)
+            {
+                out.print(" [");
+                out.print(t.guard->name);
+                out.print(" ");
+                out.print(static_cast<unsigned>(t.arg));
+                out.print("]");
+            }
+            if (t.to == NO_STATE)
+            {
+                out.print(" (internal)");
+            }
+            out.print("\"];\n");
+        }
+        out.print("}\n");
+    }
+
+    const StateDef *states;
+    const Transition *transitions;
+    uint8_t transitionCount;
+    const char *const *eventNames;
+    uint8_t timeoutEvent;
+    uint8_t first[STATES][EVENTS]; ///< first transition handling each event, or NONE
+
+private:
+    constexpr bool same(uint8_t i, uint8_t j) const
+    {
+        return transitions[i].from == transitions[j].from && transitions[i].event == transitions[j].event;
+    }
+
+    template <class Out>
+    void edge(Out &out, uint8_t from, uint8_t to) const
+    {
+        out.print("  \"");
+        out.print(states[from].name);
+        out.print("\" -> \"");
+        out.print(states[to].name);
+        out.print("\"");
+    }
+};
+
+template <class Chart>
+class StateMachine
+{
+public:
+    explicit StateMachine(const Chart &chart) : _chart(chart) {}
+
+    /// Enter `state` and its ancestors, top first
+    void start(uint8_t state)
+    {
+        _state = NO_STATE;
+        enterDown(NO_STATE, state);
+    }
+
+    /// Take the transition for `event`; false if nothing handles it here
+    bool dispatch(uint8_t event)
+    {
+        if (_state == NO_STATE || event >= Chart::EVENT_COUNT)
+        {
+            return false;
+        }
+        uint8_t i = _chart.first[_state][event];
+        if (i == Chart::NONE)
+        {
+            return false;
+        }
+        const uint8_t from = _chart.transitions[i].from;
+        for (; i < _chart.transitionCount; i++)
+        {
+            const Transition &t = _chart.transitions[i];
+            if (t.from != from || t.event != event)
+            {
+                break;
+            }
+            if (!t.guard || t.guard->test(t.arg))
+            {
+                take(t);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Dispatch `event` once the current run action returns
+    void post(uint8_t event) { _posted = event; }
+
+    /// Once per loop pass: the timeout, the current state's run action,
+    /// and what it posted
+    void run()
+    {
+        if (_state == NO_STATE)
+        {
+            return;
+        }
+        const uint32_t timeoutMs = _chart.states[_state].timeoutMs;
+        if (timeoutMs && !_timedOut && millis() - _enteredAt >= timeoutMs)
+        {
+            _timedOut = true;
+            dispatch(_chart.timeoutEvent);
+        }
+        if (_chart.states[_state].run)
+        {
+            _chart.states[_state].run();
+        }
+        while (_posted != NO_EVENT)
+        {
+            const uint8_t event = _posted;
+            _posted = NO_EVENT;
+            dispatch(event);
+        }
+    }
+
+    uint8_t state() const { return _state; }
+
+    /// The current state is `state` or inside it
+    bool in(uint8_t state) const { return _state != NO_STATE && _chart.contains(state, _state); }
+
+    /// Transitions taken since start(), internal ones included
+    uint32_t transitions() const { return _transitions; }
+
+    const Chart &chart() const { return _chart; }
+
+private:
+    void take(const Transition &t)
+    {
+        _transitions++;
+        if (t.action)
+        {
+            t.action();
+        }
+        if (t.to == NO_STATE)
+        {
+            return;
+        }
+
+        // the deepest state both ends are in; a self transition leaves it
+        uint8_t top = _state;
+        while (top != NO_STATE && !_chart.contains(top, t.to))
+        {
+            top = _chart.states[top].parent;
+        }
+        if (top == t.to && top == _state)
+        {
+            top = _chart.states[top].parent;
+        }
+
+        while (_state != top)
+        {
+            const StateDef &leaving = _chart.states[_state];
+            if (leaving.exit)
+            {
+                leaving.exit();
+            }
+            _state = leaving.parent;
+        }
+        enterDown(top, t.to);
+    }
+
+    void enterDown(uint8_t top, uint8_t target)
+    {
+        uint8_t path[STATE_DEPTH_MAX];
+        uint8_t n = 0;
+        for (uint8_t s = target; s != top && s != NO_STATE; s = _chart.states[s].parent)
+        {
+            path[n++] = s;
+        }
+        while (n)
+        {
+            _state = path[--n];
+            if (_chart.states[_state].enter)
+            {
+                _chart.states[_state].enter();
+            }
+        }
+        _state = target;
+        _enteredAt = millis();
+        _timedOut = false;
+    }
+
+    const Chart &_chart;
+    uint8_t _state = NO_STATE;
+    uint8_t _posted = NO_EVENT;
+    bool _timedOut = false;
+    uint32_t _enteredAt = 0;
+    uint32_t _transitions = 0;
+};
+
+#endif // STATE_MACHINE_H
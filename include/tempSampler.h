@@ -0,0 +1,113 @@
+/**
+ * @file tempSampler.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Adaptive-resolution, filtered sampling of the DS18B20 bath sensor
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The DS18B20 needs 750ms for a 12 bit conversion but only ~94ms for 9 bits.
+ * Far from the control point we don't care about the fourth decimal place, we
+ * care about fresh data, so the sampler picks the resolution from the distance
+ * to the target:
+ *
+ *      |target - T| > farBandF           9 bit  (0.9F step,    94ms)
+ *      |target - T| > nearBandF         10 bit  (0.45F step,  188ms)
+ *      otherwise                        12 bit  (0.11F step,  750ms)
+ *
+ * Conversions are started and collected without blocking (the library's
+ * waitForConversion is turned off) so the UI keeps running while the sensor
+ * works.  Every raw reading goes through a low-pass or Kalman filter before
+ * it reaches the controller, and the filter also gives us the rate of change.
+ *
+ * A failed read (a probe unplugged or a broken wire) is skipped, and after
+ * SAMPLER_MAX_BAD_READS of them in a row the sample is no longer valid(),
+ * so the controller stops acting on the last good temperature.  The filter
+ * starts over from the next good reading.
+ */
+#ifndef TEMP_SAMPLER_H
+#define TEMP_SAMPLER_H
+
+#include <Arduino.h>
+#include <DallasTemperature.h>
+
+#define SAMPLER_MAX_BAD_READS 3 // in a row, then valid() goes false
+
+/// Filter applied to the raw sensor readings
+enum TempFilter : uint8_t
+{
+    FILTER_NONE,    ///< raw readings, rate from successive samples
+    FILTER_LOWPASS, ///< first order low-pass, parameter is the time constant in seconds
+    FILTER_KALMAN,  ///< constant-rate Kalman filter, parameter is the process noise (F/s^2)
+};
+
+struct TempSamplerConfig
+{
+    float farBandF = 10.0f;    ///< beyond this distance from target use 9 bit
+    float nearBandF = 3.0f;    ///< beyond this distance use 10 bit, inside it 12 bit
+    TempFilter filter = FILTER_KALMAN;
+    float filterParam = 0.05f; ///< tau (s) for FILTER_LOWPASS, process noise for FILTER_KALMAN
+};
+
+class TempSampler
+{
+public:
+    /// @param index which sensor on the (shared) 1-Wire bus, in search order
+    explicit TempSampler(DallasTemperature &sensors, uint8_t index = 0);
+
+    /// Find the sensor and switch the library to non-blocking conversions.
+    /// The bus is only searched by the first sampler to start.
+    /// Starts the first conversion; returns false if no sensor answered.
+    bool begin();
+
+    /// The temperature the controller acts on.  Drives the resolution policy.
+    void setTarget(float targetF) { _targetF = targetF; }
+
+    void configure(const TempSamplerConfig &config);
+    const TempSamplerConfig &config() const { return _config; }
+
+    /// Call every pass through the loop.  Never blocks for a conversion.
+    /// @return true when a new filtered sample is available
+    bool update();
+
+    bool present() const { return _present; } ///< the sensor answered begin()
+    bool valid() const { return _valid; } ///< a good reading, and not SAMPLER_MAX_BAD_READS failures since
+    float temperatureF() const { return _tempF; }  ///< filtered
+    float rawF() const { return _rawF; }           ///< last unfiltered reading
+    float rateFPerMin() const { return _rateFps * 60.0f; } ///< filtered rate of change
+    uint8_t resolution() const { return _resolution; }
+    uint16_t conversionMs() const { return _lastConversionMs; } ///< time the last conversion took
+    uint32_t sampleCount() const { return _samples; }
+
+private:
+    uint8_t pickResolution() const;
+    void startConversion();
+    void applyFilter(float rawF, float dt);
+
+    DallasTemperature &_sensors;
+    DeviceAddress _address;
+    uint8_t _index;
+    TempSamplerConfig _config;
+
+    float _targetF = 0.0f;
+    float _rawF = 0.0f;
+    float _tempF = 0.0f;
+    float _rateFps = 0.0f;
+
+    // Kalman covariance for the [temperature, rate] state
+    float _p00 = 0.0f, _p01 = 0.0f, _p11 = 0.0f;
+
+    uint32_t _requestedAt = 0;     // millis() when the conversion was started
+    uint32_t _lastSampleAt = 0;    // millis() of the previous good reading
+    uint32_t _samples = 0;
+    uint16_t _waitMs = 0;
+    uint16_t _lastConversionMs = 0;
+    uint8_t _resolution = 12;
+    uint8_t _badReads = 0;         // in a row
+    bool _present = false;
+    bool _converting = false;
+    bool _valid = false;
+};
+
+#endif // TEMP_SAMPLER_H
@@ -0,0 +1,90 @@
+/**
+ * @file thermalModel.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Self-learning first order model of the bath, for ETA and coasting
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The bath is treated as a single lump with a dead time between the heater
+ * switching and the sensor noticing:
+ *
+ *      dT/dt = heatRate * u(t - deadTime) - lossCoeff * (T - T_REF) + drift
+ *
+ * where u is 1 while the heater is on, and drift absorbs the ambient
+ * temperature (drift = lossCoeff * (T_ambient - T_REF)).  heatRate, lossCoeff
+ * and drift are found by recursive least squares against the filtered rate
+ * from the TempSampler; the dead time is timed on every off->on heater edge.
+ * The least squares forgets old samples so the fit follows a changing load,
+ * but only while the covariance is small (RLS_COVARIANCE_MAX): a bath sitting
+ * with the heater off says nothing about heatRate, and forgetting through
+ * hours of that would grow its covariance without bound until it overflowed.
+ *
+ * From that we can say how long until the bath reaches a temperature, and how
+ * far it will keep rising after the heater is switched off, so the heater can
+ * be dropped early and the bath coasts into the setpoint.
+ */
+#ifndef THERMAL_MODEL_H
+#define THERMAL_MODEL_H
+
+#include <Arduino.h>
+
+class ThermalModel
+{
+public:
+    /// What gets persisted with the settings
+    struct Params
+    {
+        uint32_t magic;
+        float heatRate;   ///< F/s with the heater on
+        float lossCoeff;  ///< 1/s
+        float drift;      ///< F/s
+        float deadTimeS;  ///< heater edge to sensor response, seconds
+        uint16_t updates; ///< number of samples learned from
+    };
+
+    static constexpr uint32_t MAGIC = 0x54484D31; // 'THM1'
+    static constexpr float T_REF = 70.0f;         // centres T so the fit stays well conditioned
+    static constexpr float RLS_COVARIANCE_MAX = 300.0f; // trace of P past which forgetting stops
+
+    ThermalModel();
+
+    /// Restore learned values.  Anything without the right magic is ignored.
+    void load(const Params &params);
+    const Params &params() const { return _params; }
+
+    /// Feed one filtered sample.  Call only when the sampler has a new reading.
+    void observe(uint32_t nowMs, float tempF, float rateFps, bool heaterOn);
+
+    /// Enough data to trust the predictions
+    bool trained() const;
+
+    /// Has learned something since load() / clearDirty()
+    bool dirty() const { return _dirty; }
+    void clearDirty() { _dirty = false; }
+
+    /// Seconds until the bath reaches targetF with the heater on, -1 if unknown
+    /// or unreachable, 0 if already there.
+    long etaSeconds(float tempF, float targetF, bool heaterOn) const;
+
+    /// How much further the bath will rise if the heater is switched off now
+    float coastRiseF(float rateFps) const;
+
+    /// True when the heater should be switched off early so the bath coasts to targetF
+    bool shouldCoast(float tempF, float rateFps, float targetF) const;
+
+private:
+    void resetCovariance(float scale);
+
+    Params _params;
+    float _p[3][3];          // RLS covariance
+
+    uint32_t _edgeMs = 0;    // when the heater last changed state
+    float _edgeRate = 0.0f;  // filtered rate at the last off->on edge
+    bool _lastHeater = false;
+    bool _timingDeadTime = false;
+    bool _dirty = false;
+};
+
+#endif // THERMAL_MODEL_H
@@ -0,0 +1,69 @@
+/**
+ * @file timerPresets.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief User-defined (time, temperature) presets, most recently used first
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Two bytes a preset, up to PRESET_MAX of them, in one plain struct that
+ * lives in EEPROM as is: EEPROM.get() loads the lot at boot in one read,
+ * EEPROM.put() stores it with the other settings.
+ *
+ * Using a preset moves it to the front, so the one in use is always
+ * preset 0 - the main menu's long press runs it, and the preset list opens
+ * on it with no detents to turn.  A new preset goes in at the front too,
+ * pushing the least recently used one off the end when the list is full.
+ * No two presets are the same; making one equal to another merges them.
+ */
+#ifndef TIMER_PRESETS_H
+#define TIMER_PRESETS_H
+
+#include <Arduino.h>
+
+#define PRESET_MAX 8
+
+struct Preset
+{
+    uint8_t minutes;      ///< 1..255
+    uint8_t temperatureF; ///< 1..255
+    bool operator==(const Preset &other) const
+    {
+        return minutes == other.minutes && temperatureF == other.temperatureF;
+    }
+};
+
+struct TimerPresets
+{
+    uint8_t count;
+    uint8_t reserved;
+    Preset preset[PRESET_MAX];
+
+    /// False for erased or corrupt EEPROM
+    bool valid() const;
+
+    /// A starting list: `current` first, then a few common times at its temperature
+    void reset(Preset current);
+
+    /// Move preset `index` to the front
+    void use(uint8_t index);
+
+    /// Add a preset at the front (or move an equal one there)
+    void add(Preset p);
+
+    /// Change preset `index` in place; a duplicate of another preset is
+    /// merged.  Returns where the preset is now.
+    uint8_t edit(uint8_t index, Preset p);
+
+    /// Remove preset `index`; the last one can't be removed
+    void remove(uint8_t index);
+
+    bool full() const { return count >= PRESET_MAX; }
+    const Preset &operator[](uint8_t index) const { return preset[index]; }
+
+private:
+    int8_t find(Preset p) const;
+};
+
+#endif // TIMER_PRESETS_H
@@ -0,0 +1,35 @@
+/**
+ * @file timezones.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Lookup of POSIX TZ rules by zone name ("America/New_York")
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * The table itself is generated at build time by scripts/gen_zones.py from
+ * assets/zones.csv and lives entirely in flash.  Lookups are a binary search
+ * over the sorted index; the only RAM used is the caller's output buffer.
+ */
+#ifndef TIMEZONES_H
+#define TIMEZONES_H
+
+#include <Arduino.h>
+
+/// Longest POSIX rule in the table is well under this
+#define TZ_RULE_MAX 48
+
+/// Number of zones in the table
+uint16_t tzCount();
+
+/// Index of a zone by name, or -1 if it isn't in the table
+int16_t tzFind(const char *name);
+
+/// Copy the name / POSIX rule of zone `index` into `out`.  false if out of range.
+bool tzName(uint16_t index, char *out, size_t outLen);
+bool tzRule(uint16_t index, char *out, size_t outLen);
+
+/// Copy the POSIX rule for `name` into `out`.  false if the zone is unknown.
+bool tzLookup(const char *name, char *out, size_t outLen);
+
+#endif // TIMEZONES_H
@@ -0,0 +1,174 @@
+/**
+ * @file uiChart.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief The screens and the cleaning cycle as one state chart
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Every screen, and each step of the cycle's flow, is a state in
+ * stateMachine.h.  The tables in uiChart.cpp say where each input goes:
+ *
+ *      root
+ *        splash          the boot; BOOTED goes to resume or the menu
+ *        idle
+ *          menu
+ *          settings      saved on the way back to the menu
+ *            set_timer   the presets
+ *              edit_preset
+ *            set_temp, network, contrast, cleaner_mode
+ *          info          any press goes back to the menu
+ *            memory, diagnostics, energy (a minute), history
+ *            last_reset  what led up to the last reset (postMortem.h)
+ *          resume        (RESUME_OFFER_MS)
+ *        cycle           a run's start and end bookkeeping
+ *          timer
+ *
+ * The state names double as the screen names in the input trace.  The
+ * enter, exit, run and transition actions, and the guards, are in main.cpp.
+ * The host check in scripts/ui_graph.cpp links this chart against stubs,
+ * writes out its graph and walks it.
+ */
+#ifndef UI_CHART_H
+#define UI_CHART_H
+
+#include <Arduino.h>
+#include "stateMachine.h"
+
+enum UiState : uint8_t
+{
+    ST_ROOT,
+    ST_SPLASH,
+    ST_IDLE,
+    ST_MENU,
+    ST_SETTINGS,
+    ST_SET_TIMER,
+    ST_EDIT_PRESET,
+    ST_SET_TEMP,
+    ST_NETWORK,
+    ST_CONTRAST,
+    ST_CLEANER_MODE,
+    ST_INFO,
+    ST_MEMORY,
+    ST_DIAGNOSTICS,
+    ST_ENERGY,
+    ST_HISTORY,
+    ST_LAST_RESET,
+    ST_RESUME,
+    ST_READY_IN,
+    ST_DELAYED,
+    ST_CYCLE,
+    ST_TIMER,
+    ST_COUNT
+};
+
+enum UiEvent : uint8_t
+{
+    EV_CLICK,
+    EV_HOLD,   ///< released after longer than longPress
+    EV_DOUBLE, ///< double click
+    EV_TRIPLE, ///< triple click
+    EV_UP,     ///< encoder, one step back
+    EV_DOWN,   ///< encoder, one step on
+    EV_TIMEOUT,
+    EV_BOOTED,
+    EV_CYCLE_DONE, ///< every bath has finished
+    EV_HEAT,       ///< a delayed start has to heat now to be ready in time
+    EV_COUNT
+};
+
+// Main menu items, in the order shown
+enum MenuItems
+{
+    START_TIMER,
+    READY_IN,
+    SET_TIMER,
+    SET_TEMP,
+    NETWORK,
+    CONTRAST,
+    CLEANER_MODE,
+    HISTORY,
+    MENU_ITEMS_COUNT
+};
+
+#define ENERGY_SUMMARY_MS 60000 // the summary goes back to the menu after this
+#define RESUME_OFFER_MS 30000   // the resume question goes away after this
+
+using UiChart = StateChart<ST_COUNT, EV_COUNT>;
+extern const UiChart UI_CHART;
+
+// Guards
+bool menuAt(uint8_t item);      ///< the menu's selection is `item`
+bool resumePending(uint8_t);    ///< a checkpoint was found at boot
+bool presetIsNew(uint8_t);      ///< the preset list is on "New preset"
+bool resetCrashed(uint8_t);     ///< the last reset was a watchdog or an exception
+
+// States' enter, exit and run actions
+void splashEnter();
+void splashRun();
+void displayMenu();
+void settingsExit();
+void setTimerEnter();
+void setTimerRun();
+void editPresetEnter();
+void editPresetRun();
+void setTempEnter();
+void setTempRun();
+void contrastEnter();
+void contrastRun();
+void cleanerModeEnter();
+void cleanerModeRun();
+void memoryEnter();
+void memoryRun();
+void diagnosticsEnter();
+void diagnosticsRun();
+void energyRun();
+void historyEnter();
+void historyRun();
+void lastResetEnter();
+void lastResetRun();
+void resumeRun();
+void readyInRun();
+void delayedRun();
+void cycleEnter();
+void cycleExit();
+void timerRun();
+
+// Transition actions
+void menuNext();
+void menuPrevious();
+void toggleBacklight();
+void setTimerNext();
+void setTimerPrevious();
+void setTimerUse();
+void editPresetIncrement();
+void editPresetDecrement();
+void editPresetNextField();
+void editPresetSave();
+void setTempIncrement();
+void setTempDecrement();
+void setTempNextDigit();
+void setTempSave();
+void contrastUp();
+void contrastDown();
+void cleanerModeNext();
+void cleanerModePrevious();
+void cleanerModeSave();
+void diagnosticsScrollUp();
+void diagnosticsScrollDown();
+void historyOlder();
+void historyNewer();
+void lastResetScrollUp();
+void lastResetScrollDown();
+void resumeAccept();
+void resumeDecline();
+void readyInIncrement();
+void readyInDecrement();
+void delayedArm();
+void delayedHeat();
+void cycleStart();
+void cycleFinished();
+void cycleStopped();
+
+#endif // UI_CHART_H
@@ -0,0 +1,156 @@
+/**
+ * @file widgets.h
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Retained-mode screen parts that remember what they show
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * A widget owns a rectangle of character cells and the value drawn there.
+ * Setting the same value again does nothing; a different one marks the
+ * widget dirty.  Display::compose() then clears and redraws only the dirty
+ * widgets' cells and sends only those to the panel, so moving a menu
+ * highlight repaints two rows and a contrast step repaints three digits,
+ * instead of the whole screen.
+ *
+ * Widgets are plain classes with a draw() template, not virtual: compose()
+ * takes them (or arrays of them) as a parameter pack and everything
+ * resolves at compile time, like the rest of display.h.
+ *
+ *      Label        fixed or changing text
+ *      NumberField  a number with a suffix
+ *      MenuItem     a menu row with its highlight bar
+ */
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <Arduino.h>
+
+#define WIDGET_TEXT_MAX 20 // the widest panel, LCD_I2C_COLS
+
+class Widget
+{
+public:
+    Widget() {}
+    Widget(uint8_t col, uint8_t row, uint8_t width, uint8_t height = 1)
+        : _col(col), _row(row), _width(width), _height(height)
+    {
+    }
+
+    /// Move or size the widget (it's redrawn)
+    void place(uint8_t col, uint8_t row, uint8_t width, uint8_t height = 1)
+    {
+        _col = col;
+        _row = row;
+        _width = width;
+        _height = height;
+        _dirty = true;
+    }
+
+    uint8_t col() const { return _col; }
+    uint8_t row() const { return _row; }
+    uint8_t width() const { return _width; }
+    uint8_t height() const { return _height; }
+
+    bool dirty() const { return _dirty; }
+    void invalidate() { _dirty = true; }
+    void clean() { _dirty = false; }
+
+protected:
+    /// Copy `text` into `into`, cut to the widget's width; true if it changed
+    bool setText(char *into, const char *text)
+    {
+        uint8_t i = 0;
+        bool changed = false;
+        for (; i < _width && i < WIDGET_TEXT_MAX && text[i]; i++)
+        {
+            changed |= into[i] != text[i];
+            into[i] = text[i];
+        }
+        changed |= into[i] != '\0';
+        into[i] = '\0';
+        return changed;
+    }
+
+    uint8_t _col = 0;
+    uint8_t _row = 0;
+    uint8_t _width = 0;
+    uint8_t _height = 1;
+    bool _dirty = true;
+};
+
+class Label : public Widget
+{
+public:
+    Label() {}
+    Label(uint8_t col, uint8_t row, uint8_t width, const char *text = "")
+        : Widget(col, row, width)
+    {
+        setText(_text, text);
+    }
+
+    void set(const char *text)
+    {
+        _dirty |= setText(_text, text);
+    }
+
+    const char *text() const { return _text; }
+
+    template <class D>
+    void draw(D &display) const { display.print(_text); }
+
+private:
+    char _text[WIDGET_TEXT_MAX + 1] = {};
+};
+
+class NumberField : public Widget
+{
+public:
+    NumberField() {}
+    NumberField(uint8_t col, uint8_t row, uint8_t width, const char *suffix = "")
+        : Widget(col, row, width), _suffix(suffix)
+    {
+    }
+
+    void set(long value)
+    {
+        _dirty |= value != _value;
+        _value = value;
+    }
+
+    long value() const { return _value; }
+
+    template <class D>
+    void draw(D &display) const
+    {
+        display.print(_value);
+        display.print(_suffix);
+    }
+
+private:
+    const char *_suffix = "";
+    long _value = 0;
+};
+
+class MenuItem : public Widget
+{
+public:
+    MenuItem() {}
+    MenuItem(uint8_t row, uint8_t width) : Widget(0, row, width) {}
+
+    void set(const char *label, bool selected)
+    {
+        _dirty |= setText(_label, label) || selected != _selected;
+        _selected = selected;
+    }
+
+    template <class D>
+    void draw(D &display) const { display.menuItem(_row, _label, _selected); }
+
+private:
+    char _label[WIDGET_TEXT_MAX + 1] = {};
+    bool _selected = false;
+};
+
+#endif // WIDGETS_H
@@ -0,0 +1,286 @@
+"""
+@file asset_compiler.py
+@brief Turns assets/images/* into PCD8544-native frames in PROGMEM
+
+Runs as a PlatformIO pre: script (see extra_scripts in platformio.ini) and
+writes assetsTable.h into the build directory.  Every image in
+assets/images (PBM, PGM or PNG) is:
+
+  - scaled to fit 84x48, keeping its aspect ratio, centred on white
+  - dithered to 1 bit (Floyd-Steinberg), dark pixels are lit
+  - packed in the controller's own order: 6 banks of 84 bytes, each byte
+    a column of 8 pixels with bit 0 at the top
+
+so the firmware can copy a frame straight into the display buffer with no
+conversion at draw time.  Each frame is 504 bytes of flash, printed in the
+build log.  Standalone:
+
+    python3 scripts/asset_compiler.py assets/images assetsTable.h [--preview]
+"""
+import os
+import re
+import struct
+import sys
+import zlib
+
+# PlatformIO runs pre: scripts from the project directory, without __file__
+sys.path.insert(0, os.path.dirname(os.path.abspath(globals().get("__file__", "scripts/asset_compiler.py"))))
+from gen_util import write_if_changed  # noqa: E402
+
+WIDTH = 84
+HEIGHT = 48
+EXTENSIONS = (".pbm", ".pgm", ".png")
+
+
+# --------------------------------------------------------------------------
+# readers: all return (width, height, pixels) with pixels a list of rows of
+# floats, 0.0 black .. 1.0 white
+
+
+def _netpbm_tokens(data):
+    # header tokens, skipping comments; returns tokens and the offset after them
+    tokens = []
+    pos = 0
+    while len(tokens) < 4:
+        match = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(data, pos)
+        tokens.append(match.group(2))
+        pos = match.end()
+        if tokens[0] in (b"P1", b"P4") and len(tokens) == 3:
+            break
+    return tokens, pos + 1
+
+
+def read_netpbm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    tokens, pos = _netpbm_tokens(data)
+    kind, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    if kind == b"P4":
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            line = data[pos + y * stride: pos + (y + 1) * stride]
+            rows.append([0.0 if line[x // 8] & (0x80 >> (x % 8)) else 1.0 for x in range(width)])
+        return width, height, rows
+    if kind == b"P1":
+        bits = [c for c in data[pos - 1:] if c in b"01"]
+        return width, height, [[0.0 if bits[y * width + x] == ord("1") else 1.0
+                                for x in range(width)] for y in range(height)]
+    maxval = int(tokens[3])
+    if kind == b"P5":
+        size = 2 if maxval > 255 else 1
+        values = [int.from_bytes(data[pos + i * size: pos + (i + 1) * size], "big")
+                  for i in range(width * height)]
+    elif kind == b"P2":
+        values = [int(v) for v in data[pos - 1:].split()[: width * height]]
+    else:
+        raise ValueError("%s: unsupported netpbm type %s" % (path, kind.decode()))
+    return width, height, [[values[y * width + x] / maxval for x in range(width)] for y in range(height)]
+
+
+def read_png(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+    pos = 8
+    idat = b""
+    palette = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos: pos + 8])
+        chunk = data[pos + 8: pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [chunk[i: i + 3] for i in range(0, len(chunk), 3)]
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+    if interlace:
+        raise ValueError("%s: interlaced PNGs are not supported" % path)
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    bits = depth * channels
+    stride = (width * bits + 7) // 8
+    bpp = max(1, bits // 8)
+    raw = zlib.decompress(idat)
+
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1: (y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = previous[i]
+            c = previous[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        previous = line
+
+        def sample(x, channel):
+            if depth == 8:
+                return line[x * channels + channel]
+            if depth == 16:
+                return line[(x * channels + channel) * 2]
+            per_byte = 8 // depth
+            shift = 8 - depth * (x % per_byte + 1)
+            value = (line[x // per_byte] >> shift) & ((1 << depth) - 1)
+            return value if color == 3 else value * 255 // ((1 << depth) - 1)
+
+        row = []
+        for x in range(width):
+            if color == 3:
+                r, g, b = palette[sample(x, 0)]
+                alpha = 255
+            elif color in (0, 4):
+                r = g = b = sample(x, 0)
+                alpha = sample(x, 1) if color == 4 else 255
+            else:
+                r, g, b = sample(x, 0), sample(x, 1), sample(x, 2)
+                alpha = sample(x, 3) if color == 6 else 255
+            luma = (0.299 * r + 0.587 * g + 0.114 * b) / 255.0
+            row.append(luma * alpha / 255.0 + (1.0 - alpha / 255.0))  # over white
+        rows.append(row)
+    return width, height, rows
+
+
+def read_image(path):
+    if path.lower().endswith(".png"):
+        return read_png(path)
+    return read_netpbm(path)
+
+
+# --------------------------------------------------------------------------
+# processing
+
+
+def fit(width, height, rows):
+    # area-average scale into the panel, keeping the aspect ratio, on white
+    scale = min(WIDTH / width, HEIGHT / height)
+    w = max(1, int(round(width * scale)))
+    h = max(1, int(round(height * scale)))
+    left = (WIDTH - w) // 2
+    top = (HEIGHT - h) // 2
+    out = [[1.0] * WIDTH for _ in range(HEIGHT)]
+    for ty in range(h):
+        y0, y1 = ty * height / h, (ty + 1) * height / h
+        for tx in range(w):
+            x0, x1 = tx * width / w, (tx + 1) * width / w
+            total = area = 0.0
+            for sy in range(int(y0), min(height, int(y1 + 0.999999))):
+                wy = min(y1, sy + 1) - max(y0, sy)
+                for sx in range(int(x0), min(width, int(x1 + 0.999999))):
+                    wx = min(x1, sx + 1) - max(x0, sx)
+                    total += rows[sy][sx] * wx * wy
+                    area += wx * wy
+            out[top + ty][left + tx] = total / area if area else 1.0
+    return out
+
+
+def dither(rows):
+    # Floyd-Steinberg; True = lit (dark) pixel
+    work = [row[:] for row in rows]
+    lit = [[False] * WIDTH for _ in range(HEIGHT)]
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            old = work[y][x]
+            new = 0.0 if old < 0.5 else 1.0
+            lit[y][x] = new == 0.0
+            error = old - new
+            if x + 1 < WIDTH:
+                work[y][x + 1] += error * 7 / 16
+            if y + 1 < HEIGHT:
+                if x > 0:
+                    work[y + 1][x - 1] += error * 3 / 16
+                work[y + 1][x] += error * 5 / 16
+                if x + 1 < WIDTH:
+                    work[y + 1][x + 1] += error * 1 / 16
+    return lit
+
+
+def pack(lit):
+    # PCD8544 order: bank by bank, column by column, bit 0 at the top
+    frame = bytearray()
+    for bank in range(HEIGHT // 8):
+        for x in range(WIDTH):
+            byte = 0
+            for bit in range(8):
+                if lit[bank * 8 + bit][x]:
+                    byte |= 1 << bit
+            frame.append(byte)
+    return bytes(frame)
+
+
+def compile_image(path):
+    width, height, rows = read_image(path)
+    return width, height, pack(dither(fit(width, height, rows)))
+
+
+def preview(frame):
+    lines = []
+    for y in range(HEIGHT):
+        lines.append("".join("#" if frame[(y // 8) * WIDTH + x] & (1 << (y % 8)) else "."
+                             for x in range(WIDTH)))
+    return "\n".join(lines)
+
+
+# --------------------------------------------------------------------------
+# output
+
+
+def symbol(path):
+    return "asset_" + re.sub(r"\W", "_", os.path.splitext(os.path.basename(path))[0])
+
+
+def render(directory, show=False):
+    paths = sorted(os.path.join(directory, f) for f in os.listdir(directory)
+                   if f.lower().endswith(EXTENSIONS))
+    out = [
+        "// Generated by scripts/asset_compiler.py from %s - do not edit" % directory,
+        "// %dx%d PCD8544 frames: 6 banks x 84 columns, bit 0 at the top" % (WIDTH, HEIGHT),
+        "#pragma once",
+        "",
+        "#define ASSET_FRAME_BYTES %d" % (WIDTH * HEIGHT // 8),
+    ]
+    total = 0
+    for path in paths:
+        width, height, frame = compile_image(path)
+        total += len(frame)
+        print("asset_compiler: %-24s %4dx%-4d -> %d bytes flash" % (os.path.basename(path), width, height, len(frame)))
+        if show:
+            print(preview(frame))
+        out += ["", "// %s, %dx%d" % (os.path.basename(path), width, height),
+                "static const uint8_t %s[ASSET_FRAME_BYTES] PROGMEM = {" % symbol(path)]
+        for i in range(0, len(frame), 12):
+            out.append("    " + " ".join("0x%02x," % b for b in frame[i: i + 12]))
+        out.append("};")
+    print("asset_compiler: %d assets, %d bytes flash" % (len(paths), total))
+    out.append("")
+    return "\n".join(out)
+
+
+def generate(directory, target, show=False):
+    write_if_changed(target, render(directory, show))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    generate(sys.argv[1], sys.argv[2], "--preview" in sys.argv[3:])
+elif "Import" in globals():
+    Import("env")  # noqa: F821 - provided by PlatformIO
+
+    project = env.subst("$PROJECT_DIR")  # noqa: F821
+    generated = os.path.join(env.subst("$BUILD_DIR"), "generated")  # noqa: F821
+    generate(os.path.join(project, "assets", "images"), os.path.join(generated, "assetsTable.h"))
+    env.Append(CPPPATH=[generated])  # noqa: F821
@@ -0,0 +1,129 @@
+/**
+ * @file channel_sim.cpp
+ * @brief Host simulation: how long a bath waits for its update as channels are added
+ *
+ * Runs include/scheduler.h on a simulated clock.  Each pass of the page loop
+ * spends PAGE_US on the encoder, button and frame, then the bath updates:
+ *   - collecting a finished conversion costs READ_US (1-Wire scratchpad read
+ *     and the next conversion request), once per conversion per channel
+ *   - a relay change costs EXPANDER_US (one PCF8574 write)
+ *   - otherwise a channel update costs IDLE_US
+ * The sensors all start converting at boot, at the same resolution, so
+ * their readings fall due together.  Updating every channel every pass
+ * then stacks all the reads into one pass, which grows with the channel
+ * count; the scheduler keeps every pass within PAGE_US + one read, and no
+ * channel waits more than `channels` passes.
+ *
+ *     c++ -std=c++17 -O2 -Iscripts/host -Iinclude scripts/channel_sim.cpp -o channel_sim
+ *     ./channel_sim
+ */
+#include <cstdio>
+#include <random>
+
+#include "scheduler.h"
+
+static constexpr uint32_t PAGE_US = 9000;        // encoder, button, full frame over SW SPI
+static constexpr uint32_t READ_US = 13000;       // getTempF + requestTemperaturesByAddress
+static constexpr uint32_t EXPANDER_US = 250;     // one byte to the PCF8574 at 100kHz
+static constexpr uint32_t IDLE_US = 40;
+static constexpr uint32_t CONVERSION_US = 375000; // 11 bit, a middle of the road resolution
+static constexpr uint32_t BUDGET_US = 2000;       // CHANNEL_BUDGET_US in main.cpp
+static constexpr uint32_t RUN_US = 10UL * 60 * 1000 * 1000;
+
+static std::mt19937 s_rng(42);
+
+struct FakeChannel
+{
+    uint32_t conversionDoneUs = 0; // all started together at boot, so they stay in step
+    uint32_t updates = 0;
+
+    void update()
+    {
+        if (static_cast<int32_t>(hostMicros - conversionDoneUs) >= 0)
+        {
+            hostMicros += READ_US;
+            conversionDoneUs = hostMicros + CONVERSION_US;
+        }
+        else
+        {
+            hostMicros += IDLE_US;
+        }
+        if (s_rng() % 500 == 0) // a relay switches now and then
+        {
+            hostMicros += EXPANDER_US;
+        }
+        updates++;
+    }
+};
+
+struct Stats
+{
+    uint32_t worstWaitUs = 0;
+    uint32_t worstPassUs = 0;
+    double meanPassUs = 0.0;
+};
+
+template <class Run>
+static Stats simulate(uint8_t channels, Run runChannels)
+{
+    FakeChannel bath[SCHEDULER_MAX_TASKS];
+    uint32_t lastUs[SCHEDULER_MAX_TASKS] = {};
+    Stats stats;
+    uint32_t passes = 0;
+    hostMicros = 0;
+    while (hostMicros < RUN_US)
+    {
+        uint32_t passStart = hostMicros;
+        hostMicros += PAGE_US;
+        uint32_t before[SCHEDULER_MAX_TASKS];
+        for (uint8_t i = 0; i < channels; i++)
+        {
+            before[i] = bath[i].updates;
+        }
+        runChannels(bath, channels);
+        for (uint8_t i = 0; i < channels; i++)
+        {
+            if (bath[i].updates != before[i])
+            {
+                if (passes)
+                {
+                    stats.worstWaitUs = max(stats.worstWaitUs, hostMicros - lastUs[i]);
+                }
+                lastUs[i] = hostMicros;
+            }
+        }
+        stats.worstPassUs = max(stats.worstPassUs, hostMicros - passStart);
+        stats.meanPassUs += hostMicros - passStart;
+        passes++;
+    }
+    stats.meanPassUs /= passes;
+    return stats;
+}
+
+int main()
+{
+    printf("%8s | %-28s | %-28s\n", "", "every channel every pass", "scheduler, 2 ms budget");
+    printf("%8s | %8s %9s %9s | %8s %9s %9s\n", "channels", "mean ms", "worst ms", "wait ms",
+           "mean ms", "worst ms", "wait ms");
+    for (uint8_t channels = 1; channels <= SCHEDULER_MAX_TASKS; channels++)
+    {
+        Stats all = simulate(channels, [](FakeChannel *bath, uint8_t count)
+        {
+            for (uint8_t i = 0; i < count; i++)
+            {
+                bath[i].update();
+            }
+        });
+
+        Scheduler scheduler(BUDGET_US);
+        Stats scheduled = simulate(channels, [&](FakeChannel *bath, uint8_t count)
+        {
+            scheduler.run(bath, count);
+        });
+
+        printf("%8u | %8.1f %9.1f %9.1f | %8.1f %9.1f %9.1f\n", channels,
+               all.meanPassUs / 1000.0, all.worstPassUs / 1000.0, all.worstWaitUs / 1000.0,
+               scheduled.meanPassUs / 1000.0, scheduled.worstPassUs / 1000.0, scheduled.worstWaitUs / 1000.0);
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file delay_sim.cpp
+ * @brief Host simulation: a delayed start (include/delayedStart.h) against heating at once
+ *
+ * The bath is a lump with a dead time, the same shape ThermalModel assumes:
+ *
+ *      dT/dt = HEAT_FPS * u(t - DEAD_S) - LOSS * (T - ambient)
+ *
+ * A ThermalModel learns it first, from a few hours of the heater cycling
+ * in a 70F room.  Then, for each delay, the baths are wanted DELAY minutes
+ * from now, and two runs are compared up to that time:
+ *   - "at once": the heater goes on straight away, as starting the timer does
+ *   - "delayed": the heater stays off until DelayedStart::due()
+ * Both then hold the ready temperature with a plain thermostat.  A 60F
+ * room, which the model never saw, shows what the margin is for.
+ *
+ * For each run: the heater's on time (and Wh at HEATER_WATTS), how long the
+ * bath sat at temperature before it was wanted, when it got there (minutes
+ * before it was wanted; negative is late) and its temperature at that time.
+ *
+ *     c++ -std=c++17 -O2 -Iscripts/host -Iinclude scripts/delay_sim.cpp src/delayedStart.cpp src/thermalModel.cpp -o delay_sim
+ *     ./delay_sim
+ */
+#include <cstdio>
+
+#include "delayedStart.h"
+#include "energy.h"
+#include "thermalModel.h"
+
+static constexpr float HEAT_FPS = 0.04f;      // 2.4F a minute with the heater on
+static constexpr float LOSS = 1.0f / 4000.0f; // 1/s
+static constexpr uint32_t DEAD_S = 30;
+static constexpr float READY_F = 130.0f;      // 140F set, tempOffset below
+static constexpr float HYSTERESIS_F = 0.5f;
+static constexpr uint32_t TRAIN_S = 4 * 3600;
+
+struct Bath
+{
+    float tempF;
+    float ambientF;
+    bool heater = false;
+    bool history[DEAD_S] = {}; // the heater's last DEAD_S seconds
+    uint8_t head = 0;
+    float rateFps = 0.0f;
+
+    explicit Bath(float ambient) : tempF(ambient), ambientF(ambient) {}
+
+    /// One second
+    void step()
+    {
+        const bool effective = history[head];
+        history[head] = heater;
+        head = (head + 1) % DEAD_S;
+        rateFps = (effective ? HEAT_FPS : 0.0f) - LOSS * (tempF - ambientF);
+        tempF += rateFps;
+    }
+
+    void thermostat()
+    {
+        if (tempF < READY_F - HYSTERESIS_F)
+        {
+            heater = true;
+        }
+        else if (tempF >= READY_F)
+        {
+            heater = false;
+        }
+    }
+};
+
+static ThermalModel train()
+{
+    ThermalModel model;
+    Bath bath(70.0f);
+    for (uint32_t s = 0; s < TRAIN_S; s++)
+    {
+        // an hour holding temperature, then an hour cooling, twice
+        if ((s / 3600) % 2 == 0)
+        {
+            bath.thermostat();
+        }
+        else
+        {
+            bath.heater = false;
+        }
+        bath.step();
+        model.observe(s * 1000, bath.tempF, bath.rateFps, bath.heater);
+    }
+    return model;
+}
+
+struct Result
+{
+    uint32_t heaterS = 0;
+    uint32_t heldS = 0;
+    long readyS = -1; ///< when it first got to temperature
+    float endF = 0.0f;
+};
+
+static Result simulate(ThermalModel model, float ambientF, uint32_t delayS, bool delayed)
+{
+    // the clock carries on from the training, as millis() would
+    const uint32_t startMs = TRAIN_S * 1000;
+    Bath bath(ambientF);
+    DelayedStart start;
+    start.arm(startMs, delayS);
+    bool heating = !delayed;
+    Result result;
+    for (uint32_t s = 0; s < delayS; s++)
+    {
+        if (!heating)
+        {
+            heating = start.due(startMs + s * 1000, model.etaSeconds(bath.tempF, READY_F, false));
+        }
+        if (heating)
+        {
+            bath.thermostat();
+        }
+        bath.step();
+        model.observe(startMs + s * 1000, bath.tempF, bath.rateFps, bath.heater);
+
+        result.heaterS += bath.heater;
+        if (bath.tempF >= READY_F - HYSTERESIS_F)
+        {
+            result.heldS++;
+            if (result.readyS < 0)
+            {
+                result.readyS = s;
+            }
+        }
+    }
+    result.endF = bath.tempF;
+    return result;
+}
+
+static void print(const char *name, const Result &r, uint32_t delayS)
+{
+    printf("  %-9s %6.1f %7.0f %8.1f ", name, r.heaterS / 60.0f, energyWh(r.heaterS * 1000000ULL, HEATER_WATTS),
+           r.heldS / 60.0f);
+    if (r.readyS < 0)
+    {
+        printf("%8s", "never");
+    }
+    else
+    {
+        printf("%8.1f", (static_cast<long>(delayS) - r.readyS) / 60.0f);
+    }
+    printf(" %7.1f\n", r.endF);
+}
+
+int main()
+{
+    const ThermalModel model = train();
+    const ThermalModel::Params &p = model.params();
+    printf("learned: heat %.4f F/s (%.4f), loss %.6f /s (%.6f), dead time %.0f s (%u), %s\n",
+           p.heatRate, HEAT_FPS, p.lossCoeff, LOSS, p.deadTimeS, DEAD_S, model.trained() ? "trained" : "NOT trained");
+
+    int failures = 0;
+    for (float ambientF : {70.0f, 60.0f})
+    {
+        for (uint32_t minutes : {30, 60, 120, 240, 480})
+        {
+            const uint32_t delayS = minutes * 60;
+            printf("\n%.0fF room, wanted in %u min  heater min      Wh  held min  early min  temp F\n", ambientF, minutes);
+            const Result now = simulate(model, ambientF, delayS, false);
+            const Result later = simulate(model, ambientF, delayS, true);
+            print("at once", now, delayS);
+            print("delayed", later, delayS);
+            // it has to be ready in time whenever heating at once would have been
+            if (now.readyS >= 0 && later.readyS < 0)
+            {
+                printf("  FAIL: delayed start not ready in time\n");
+                failures++;
+            }
+        }
+    }
+    return failures ? 1 : 0;
+}
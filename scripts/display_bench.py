@@ -0,0 +1,108 @@
+"""
+@file display_bench.py
+@brief Compares the display backends on RAM, flash and frame time
+
+Builds every bench_* environment in platformio.ini, reads the memory use
+out of each ELF (same region sums as size_report.py) and prints a table.
+With --port it also uploads each build in turn and reads the frame time
+the firmware measures at boot (the DISPLAY_BENCH line on the serial port),
+so swap the panel to match before each upload when prompted.
+
+The bench_u8g2_page1/page2 builds run the same panel in U8g2 page buffer
+mode; "saved" is their DRAM saving over bench_u8g2 and "extra us" the
+extra time per frame it costs.
+
+The firmware also counts the panel's bus transfers on the idle menu and
+the contrast screen (DISPLAY_BENCH_BUS lines): sending the contrast every
+pass against the cached settings going out with the frame when they change.
+
+    python3 scripts/display_bench.py
+    python3 scripts/display_bench.py --port /dev/cu.wchusbserial1410
+"""
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import size_report  # noqa: E402
+
+ENVS = ["bench_u8g2", "bench_u8g2_page2", "bench_u8g2_page1", "bench_pcd8544", "bench_lcd_i2c"]
+BENCH_LINE = re.compile(r"DISPLAY_BENCH .*buffer=(\d+) pages=(\d+) .*frame_us=(\d+) flush_us=(\d+) worst_us=(\d+)")
+BUS_LINE = re.compile(r"DISPLAY_BENCH_BUS .*screen=(\w+) .*every_pass_tps=(\d+) coalesced_tps=(\d+)")
+BUS_SCREENS = 2
+
+
+def build(env):
+    subprocess.check_call(["pio", "run", "-e", env])
+    meta = json.loads(subprocess.check_output(["pio", "project", "metadata", "-e", env, "--json-output"]))
+    data = meta[env]
+    gcc = data["cc_path"]
+    return data["prog_path"], size_report.tool_from_gcc(gcc, "size")
+
+
+def measure(env, port, timeout):
+    import serial  # pyserial ships with PlatformIO
+
+    input("Fit the panel for %s and press Enter to upload..." % env)
+    subprocess.check_call(["pio", "run", "-e", env, "-t", "upload", "--upload-port", port])
+    timing = None
+    bus = []
+    with serial.Serial(port, 115200, timeout=timeout) as link:
+        while len(bus) < BUS_SCREENS:
+            line = link.readline().decode("ascii", "replace")
+            if not line:
+                break
+            match = BENCH_LINE.search(line)
+            if match:
+                timing = tuple(int(v) for v in match.groups())
+            match = BUS_LINE.search(line)
+            if match:
+                bus.append((match.group(1), int(match.group(2)), int(match.group(3))))
+    return timing, bus
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Display backend benchmark")
+    parser.add_argument("--port", help="upload each build and read its frame time")
+    parser.add_argument("--timeout", type=float, default=20.0)
+    parser.add_argument("envs", nargs="*", default=ENVS)
+    args = parser.parse_args()
+
+    rows = []
+    for env in args.envs:
+        elf, size_tool = build(env)
+        used = size_report.usage(size_report.read_sections(elf, size_tool))
+        timing, bus = measure(env, args.port, args.timeout) if args.port else (None, [])
+        rows.append((env, used, timing, bus))
+
+    # page buffer builds are compared against the full buffer U8g2 build
+    base = next((r for r in rows if r[0] == "bench_u8g2"), None)
+
+    print()
+    print("%-18s %7s %7s %8s %7s %7s %6s %9s %9s %9s %9s" % (
+        "backend", "DRAM", "IRAM", "flash", "saved", "buffer", "pages",
+        "frame us", "flush us", "worst us", "extra us"))
+    for env, used, timing, _ in rows:
+        saved = base[1]["DRAM"] - used["DRAM"] if base else 0
+        if timing:
+            buffer, pages, frame, flush, worst = timing
+            extra = frame - base[2][2] if base and base[2] else 0
+            times = "%7d %6d %9d %9d %9d %9d" % (buffer, pages, frame, flush, worst, extra)
+        else:
+            times = "%7s %6s %9s %9s %9s %9s" % ("-", "-", "-", "-", "-", "-")
+        print("%-18s %7d %7d %8d %7d %s" % (env, used["DRAM"], used["IRAM"], used["FLASH"], saved, times))
+
+    if any(r[3] for r in rows):
+        print()
+        print("%-18s %-9s %14s %14s %7s" % ("backend", "screen", "every pass/s", "coalesced/s", "saved"))
+        for env, _, _, bus in rows:
+            for screen, every, coalesced in bus:
+                saved = "%d%%" % (100 - 100 * coalesced // every) if every else "-"
+                print("%-18s %-9s %14d %14d %7s" % (env, screen, every, coalesced, saved))
+
+
+if __name__ == "__main__":
+    main()
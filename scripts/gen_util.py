@@ -0,0 +1,22 @@
+"""
+@file gen_util.py
+@brief Helpers shared by the build-time generators in scripts/
+"""
+import os
+
+
+def write_if_changed(path, text):
+    """Write `text` to `path` unless it already holds exactly that.
+
+    The generated headers are included by the firmware, so rewriting one
+    with the same contents would still rebuild everything that includes it.
+    Returns True if the file was written.
+    """
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return False
+    os.makedirs(os.path.dirname(path) or ".", exist_ok=True)
+    with open(path, "w") as f:
+        f.write(text)
+    return True
@@ -0,0 +1,125 @@
+"""
+@file gen_zones.py
+@brief Builds the PROGMEM timezone table from assets/zones.csv
+
+Runs as a PlatformIO pre: script (see extra_scripts in platformio.ini) and
+writes zonesTable.h into the build directory, which is added to the include
+path.  The table is sorted by zone name so the firmware can binary search
+it, and every string (names and POSIX TZ rules) lives once in a single
+pool; the index is two uint16_t offsets per zone.
+
+assets/zones.csv is one "Area/Location","POSIX TZ" pair per line.  To
+refresh it from a tzdata install (the POSIX rule is the last line of each
+TZif v2+ file):
+
+    python3 scripts/gen_zones.py --from-zoneinfo /usr/share/zoneinfo > assets/zones.csv
+
+Standalone:
+
+    python3 scripts/gen_zones.py assets/zones.csv zonesTable.h
+"""
+import csv
+import os
+import sys
+
+# PlatformIO runs pre: scripts from the project directory, without __file__
+sys.path.insert(0, os.path.dirname(os.path.abspath(globals().get("__file__", "scripts/gen_zones.py"))))
+from gen_util import write_if_changed  # noqa: E402
+
+SKIP = {"posix", "right", "posixrules", "localtime", "Factory", "SystemV"}
+
+
+def read_zones(path):
+    zones = {}
+    with open(path, newline="") as f:
+        for row in csv.reader(f):
+            if len(row) != 2 or row[0].startswith("#"):
+                continue
+            name, tz = row[0].strip(), row[1].strip()
+            if not name or not tz:
+                continue
+            zones[name] = tz
+    return zones
+
+
+def from_zoneinfo(root):
+    zones = {}
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames[:] = [d for d in dirnames if d not in SKIP]
+        for fn in filenames:
+            if fn in SKIP:
+                continue
+            path = os.path.join(dirpath, fn)
+            with open(path, "rb") as f:
+                data = f.read()
+            if not data.startswith(b"TZif") or data[4:5] < b"2":
+                continue
+            footer = data.rstrip(b"\n").rsplit(b"\n", 1)[-1].decode("ascii")
+            if footer:
+                zones[os.path.relpath(path, root)] = footer
+    return zones
+
+
+def c_string(s):
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '\\0"'
+
+
+def render(zones, source):
+    names = sorted(zones)
+    pool = []
+    offsets = {}
+    size = 0
+
+    def intern(s):
+        nonlocal size
+        if s not in offsets:
+            offsets[s] = size
+            pool.append(s)
+            size += len(s) + 1
+        return offsets[s]
+
+    index = [(intern(n), intern(zones[n])) for n in names]
+    if size > 0xFFFF:
+        raise SystemExit("gen_zones: string pool is %d bytes, offsets are 16 bit" % size)
+
+    out = [
+        "// Generated by scripts/gen_zones.py from %s - do not edit" % source,
+        "// %d zones, %d byte string pool, %d byte index" % (len(names), size, len(index) * 4),
+        "#pragma once",
+        "",
+        "#define TZ_COUNT %d" % len(names),
+        "#define TZ_RULE_LONGEST %d" % max(len(t) for t in zones.values()),
+        "",
+        "static const char TZ_POOL[] PROGMEM =",
+    ]
+    out += ["    " + c_string(s) for s in pool]
+    out[-1] += ";"
+    out += ["", "// {name, rule} offsets into TZ_POOL, sorted by name",
+            "static const uint16_t TZ_INDEX[TZ_COUNT][2] PROGMEM = {"]
+    out += ["    {%d, %d}, // %s" % (n, t, name) for (n, t), name in zip(index, names)]
+    out += ["};", ""]
+    return "\n".join(out)
+
+
+def generate(source, target):
+    text = render(read_zones(source), os.path.basename(source))
+    if write_if_changed(target, text):
+        print("gen_zones: wrote %s" % target)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) == 3 and sys.argv[1] == "--from-zoneinfo":
+        w = csv.writer(sys.stdout, quoting=csv.QUOTE_ALL, lineterminator="\n")
+        for name, tz in sorted(from_zoneinfo(sys.argv[2]).items()):
+            w.writerow([name, tz])
+    elif len(sys.argv) == 3:
+        generate(sys.argv[1], sys.argv[2])
+    else:
+        sys.exit(__doc__)
+else:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+
+    project = env.subst("$PROJECT_DIR")  # noqa: F821
+    generated = os.path.join(env.subst("$BUILD_DIR"), "generated")  # noqa: F821
+    generate(os.path.join(project, "assets", "zones.csv"), os.path.join(generated, "zonesTable.h"))
+    env.Append(CPPPATH=[generated])  # noqa: F821
@@ -0,0 +1,47 @@
+// Just enough of Arduino.h to build the hardware independent modules on a
+// PC, for the host benchmarks in scripts/.  Pins are recorded, not driven.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+
+using std::max;
+using std::min;
+
+// the clock is whatever the benchmark says it is
+inline uint32_t hostMicros = 0;
+inline uint32_t micros() { return hostMicros; }
+inline uint64_t micros64() { return hostMicros; }
+inline uint32_t millis() { return hostMicros / 1000; }
+
+inline uint8_t hostPins[32];
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t level) { hostPins[pin] = level; }
+
+// timer1 and the GPIO registers are accepted and ignored: the modulated
+// cleaner output (cleanerMod.cpp) links, but never runs a pattern here
+#define IRAM_ATTR
+#define TIM_DIV256 3
+#define TIM_EDGE 0
+#define TIM_SINGLE 0
+inline uint32_t GPOS, GPOC;
+inline void timer1_attachInterrupt(void (*)()) {}
+inline void timer1_detachInterrupt() {}
+inline void timer1_enable(uint8_t, uint8_t, uint8_t) {}
+inline void timer1_disable() {}
+inline void timer1_write(uint32_t) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+struct HostEsp
+{
+    uint32_t getCycleCount() const { return hostMicros * 80; }
+    uint8_t getCpuFreqMHz() const { return 80; }
+};
+inline HostEsp ESP;
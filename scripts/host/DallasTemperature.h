@@ -0,0 +1,31 @@
+// A DS18B20 on the host: one per index, reading whatever the simulation
+// puts in hostSensorF[] (see Arduino.h here).  DEVICE_DISCONNECTED_F there
+// is an unplugged probe.
+#pragma once
+
+#include "Arduino.h"
+
+#define DEVICE_DISCONNECTED_F -196.6f
+
+typedef uint8_t DeviceAddress[8];
+
+inline float hostSensorF[4];
+
+class DallasTemperature
+{
+public:
+    uint8_t getDeviceCount() const { return 4; }
+    void begin() {}
+    bool getAddress(DeviceAddress address, uint8_t index)
+    {
+        memset(address, 0, sizeof(DeviceAddress));
+        address[0] = index;
+        return index < 4;
+    }
+    void setAutoSaveScratchPad(bool) {}
+    void setWaitForConversion(bool) {}
+    bool setResolution(const uint8_t *, uint8_t) { return true; }
+    uint16_t millisToWaitForConversion(uint8_t resolution) const { return 750 / (1 << (12 - resolution)); }
+    bool requestTemperaturesByAddress(const uint8_t *) { return true; }
+    float getTempF(const uint8_t *address) const { return hostSensorF[address[0]]; }
+};
@@ -0,0 +1,13 @@
+// I2C that goes nowhere, for the host benchmarks (see Arduino.h here)
+#pragma once
+
+#include "Arduino.h"
+
+struct HostWire
+{
+    void begin(int, int) {}
+    void beginTransmission(uint8_t) {}
+    size_t write(uint8_t) { return 1; }
+    uint8_t endTransmission() { return 0; }
+};
+inline HostWire Wire;
@@ -0,0 +1,177 @@
+/**
+ * @file relay_bench.cpp
+ * @brief Host benchmark: relay toggles on noisy readings, the old control against BathChannel
+ *
+ * Simulates the bath (the first order model with dead time from
+ * thermalModel.h) heating to the ready temperature and holding there, with
+ * the reading carrying sensor noise and 10 bit quantisation.  The same run
+ * is controlled the old way (heater on below ready, cleaner on at ready,
+ * decided every pass on the raw reading) and by a BathChannel
+ * (src/bathChannel.cpp) - its sampler, relay filter and Relays - and the
+ * switch counts and how well the bath holds are compared:
+ *   - "ready": the minute the bath first reached ready, or "never"
+ *   - "|err| F" and "clean %": mean |T - ready| and the cleaner's duty over
+ *     the second half of the run, when the bath should have settled
+ *   - "overlap": passes with the heater and the cleaner both on
+ * The exit code is 1 if a BathChannel run never got to ready or ran the
+ * two together.
+ *
+ *     c++ -std=c++17 -O2 -Iscripts/host -Iinclude scripts/relay_bench.cpp src/bathChannel.cpp src/tempSampler.cpp src/thermalModel.cpp src/relay.cpp src/outputs.cpp src/cleanerMod.cpp -o relay_bench
+ *     ./relay_bench
+ */
+#include <cstdio>
+#include <random>
+
+#include "bathChannel.h"
+
+static constexpr uint32_t PASS_MS = 20;         // one pass of the timer page loop
+static constexpr uint32_t CONVERSION_MS = 188;  // 10 bit DS18B20 conversion
+static constexpr uint32_t RUN_MS = 40UL * 60 * 1000;
+static constexpr uint32_t SETTLED_MS = RUN_MS / 2;
+static constexpr float READY_F = 130.0f;
+static constexpr float AMBIENT_F = 70.0f;
+static constexpr float HEAT_RATE = 0.06f;   // F/s with the heater on
+static constexpr float LOSS = 0.0004f;      // 1/s
+static constexpr uint32_t DEAD_MS = 15000;  // heater to sensor
+static constexpr float STEP_F = 0.1125f;    // 10 bit step
+
+struct Result
+{
+    uint32_t heaterSwitches = 0;
+    uint32_t cleanerSwitches = 0;
+    uint32_t overlapPasses = 0; // heater and cleaner both on
+    float peakF = 0.0f;
+    long readyMs = -1;          // first reached ready, -1 never
+    float meanErrorF = 0.0f;    // |T - ready| from SETTLED_MS
+    float cleanerDuty = 0.0f;   // from SETTLED_MS
+};
+
+class Bath
+{
+public:
+    explicit Bath(float noiseF) : _rng(1234), _noise(noiseF) {}
+
+    // advance one pass with the heater as given, return the current reading
+    float step(bool heaterOn, uint32_t nowMs)
+    {
+        _history[(nowMs / PASS_MS) % HISTORY] = heaterOn;
+        bool delayed = _history[((nowMs - DEAD_MS) / PASS_MS) % HISTORY] && nowMs >= DEAD_MS;
+        float dt = PASS_MS / 1000.0f;
+        _tempF += ((delayed ? HEAT_RATE : 0.0f) - LOSS * (_tempF - AMBIENT_F)) * dt;
+        if (nowMs % CONVERSION_MS < PASS_MS)
+        {
+            float noisy = _tempF + _noise * gaussian();
+            _readingF = STEP_F * roundf(noisy / STEP_F);
+        }
+        return _readingF;
+    }
+
+    float tempF() const { return _tempF; }
+
+private:
+    static constexpr uint32_t HISTORY = DEAD_MS / PASS_MS + 1;
+
+    float gaussian()
+    {
+        // Box-Muller, so the run is the same on every standard library
+        float u1 = (_rng() + 1.0f) / 4294967297.0f;
+        float u2 = _rng() / 4294967296.0f;
+        return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+    }
+
+    std::mt19937 _rng;
+    float _noise;
+    float _tempF = AMBIENT_F;
+    float _readingF = AMBIENT_F;
+    bool _history[HISTORY] = {};
+};
+
+template <class Control>
+static Result run(float noiseF, Control control)
+{
+    Bath bath(noiseF);
+    Result result;
+    bool heater = false;
+    bool cleaner = false;
+    double errorSum = 0.0;
+    uint32_t cleanerPasses = 0;
+    uint32_t settledPasses = 0;
+    for (uint32_t now = 0; now < RUN_MS; now += PASS_MS)
+    {
+        float reading = bath.step(heater, now);
+        bool nextHeater = heater;
+        bool nextCleaner = cleaner;
+        control(reading, now, nextHeater, nextCleaner);
+        result.heaterSwitches += nextHeater != heater;
+        result.cleanerSwitches += nextCleaner != cleaner;
+        heater = nextHeater;
+        cleaner = nextCleaner;
+        result.overlapPasses += heater && cleaner;
+
+        result.peakF = max(result.peakF, bath.tempF());
+        if (result.readyMs < 0 && bath.tempF() >= READY_F)
+        {
+            result.readyMs = now;
+        }
+        if (now >= SETTLED_MS)
+        {
+            errorSum += fabsf(bath.tempF() - READY_F);
+            cleanerPasses += cleaner;
+            settledPasses++;
+        }
+    }
+    result.meanErrorF = errorSum / settledPasses;
+    result.cleanerDuty = 100.0f * cleanerPasses / settledPasses;
+    return result;
+}
+
+static void print(const char *name, float noiseF, const Result &r)
+{
+    printf("%-8s %5.2f %7u %8u %7.2f ", name, noiseF, r.heaterSwitches, r.cleanerSwitches, r.peakF);
+    if (r.readyMs < 0)
+    {
+        printf("%6s", "never");
+    }
+    else
+    {
+        printf("%6.1f", r.readyMs / 60000.0f);
+    }
+    printf(" %7.2f %7.0f %7u\n", r.meanErrorF, r.cleanerDuty, r.overlapPasses);
+}
+
+int main()
+{
+    printf("%-8s %5s %7s %8s %7s %6s %7s %7s %7s\n", "control", "noise", "heater", "cleaner", "peak F",
+           "ready", "|err| F", "clean %", "overlap");
+    int failures = 0;
+    for (float noiseF : {0.05f, 0.2f, 0.5f, 1.0f})
+    {
+        Result direct = run(noiseF, [](float reading, uint32_t, bool &heater, bool &cleaner)
+        {
+            heater = reading < READY_F;
+            cleaner = !heater;
+        });
+
+        hostMicros = 0;
+        hostSensorF[0] = AMBIENT_F;
+        DallasTemperature sensors;
+        BathChannel channel(sensors, 0, 1, 2);
+        channel.begin();
+        channel.beginSensor();
+        channel.setReadyTemperature(READY_F);
+        channel.start(RUN_MS / 1000 + 1);
+        Result relayed = run(noiseF, [&](float reading, uint32_t now, bool &heater, bool &cleaner)
+        {
+            hostMicros = now * 1000;
+            hostSensorF[0] = reading;
+            channel.update();
+            heater = channel.heater().isOn();
+            cleaner = channel.cleaner().isOn();
+        });
+
+        print("direct", noiseF, direct);
+        print("channel", noiseF, relayed);
+        failures += relayed.readyMs < 0 || relayed.overlapPasses != 0;
+    }
+    return failures ? 1 : 0;
+}
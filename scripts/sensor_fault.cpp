@@ -0,0 +1,85 @@
+/**
+ * @file sensor_fault.cpp
+ * @brief Host check: a probe failing mid-run turns both relays off
+ *
+ * Runs a BathChannel (src/bathChannel.cpp) against a simulated bath, and
+ * pulls the probe out twice - once while it heats, once while it cleans.
+ * From then on every read is DEVICE_DISCONNECTED_F; within
+ * SAMPLER_MAX_BAD_READS conversions the sample has to go invalid and both
+ * relays have to drop, and stay down until the probe is back.
+ *
+ *     c++ -std=c++17 -O2 -Iscripts/host -Iinclude scripts/sensor_fault.cpp src/bathChannel.cpp src/tempSampler.cpp src/thermalModel.cpp src/relay.cpp src/outputs.cpp src/cleanerMod.cpp -o sensor_fault
+ *     ./sensor_fault
+ */
+#include <cstdio>
+
+#include "bathChannel.h"
+
+static constexpr uint32_t PASS_MS = 20;
+static constexpr float READY_F = 130.0f;
+static constexpr float HEAT_FPS = 0.06f;
+static constexpr float LOSS = 0.0004f; // 1/s
+static constexpr float AMBIENT_F = 70.0f;
+static constexpr uint32_t LIMIT_MS = SAMPLER_MAX_BAD_READS * 750 + 1000; // 12 bit conversions, and some
+
+static DallasTemperature s_sensors;
+static float s_bathF = AMBIENT_F;
+
+/// One pass: the bath moves, the channel samples and controls
+static void pass(BathChannel &channel, bool plugged)
+{
+    hostMicros += PASS_MS * 1000;
+    s_bathF += ((channel.heater().isOn() ? HEAT_FPS : 0.0f) - LOSS * (s_bathF - AMBIENT_F)) * PASS_MS / 1000.0f;
+    hostSensorF[0] = plugged ? s_bathF : DEVICE_DISCONNECTED_F;
+    channel.update();
+}
+
+/// Pull the probe once `which` relay is on; true if both relays drop in time and stay off
+static bool unplugWhen(BathChannel &channel, const char *name, bool (*ready)(BathChannel &))
+{
+    while (!ready(channel))
+    {
+        pass(channel, true);
+    }
+    const uint32_t pulledMs = millis();
+    uint32_t droppedMs = 0;
+    for (uint32_t t = 0; t < 60000; t += PASS_MS)
+    {
+        pass(channel, false);
+        const bool off = !channel.heater().isOn() && !channel.cleaner().isOn();
+        if (!off && droppedMs)
+        {
+            printf("%-8s a relay came back on %u ms after the probe was pulled: FAIL\n", name, millis() - pulledMs);
+            return false;
+        }
+        if (off && !droppedMs)
+        {
+            droppedMs = millis();
+        }
+    }
+    const bool ok = droppedMs && droppedMs - pulledMs <= LIMIT_MS && !channel.sampler().valid();
+    printf("%-8s relays off %u ms after the probe was pulled (limit %u), phase %s: %s\n", name,
+           droppedMs ? droppedMs - pulledMs : 0, LIMIT_MS, channel.status(), ok ? "ok" : "FAIL");
+
+    // plugged back in, it carries on
+    for (uint32_t t = 0; t < 5000; t += PASS_MS)
+    {
+        pass(channel, true);
+    }
+    return ok;
+}
+
+int main()
+{
+    BathChannel channel(s_sensors, 0, 4, 5);
+    channel.begin();
+    hostSensorF[0] = s_bathF;
+    channel.beginSensor();
+    channel.setReadyTemperature(READY_F);
+    channel.start(3600);
+
+    int failures = 0;
+    failures += !unplugWhen(channel, "heating", [](BathChannel &c) { return c.heater().isOn() && c.sampler().valid(); });
+    failures += !unplugWhen(channel, "cleaning", [](BathChannel &c) { return c.cleaner().isOn(); });
+    return failures ? 1 : 0;
+}
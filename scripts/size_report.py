@@ -0,0 +1,150 @@
+"""
+@file size_report.py
+@brief Memory budget report for the firmware ELF
+
+Runs as a PlatformIO post: script.  After every link it prints how much of
+each ESP8266 memory region the firmware uses and fails the build when a
+region goes over its limit.  The limits are only set in platformio.ini
+(a region without one is reported but not checked):
+
+    custom_limit_dram  = 61440    ; .data + .rodata + .bss, 60 KB of ~80 KB
+    custom_limit_iram  = 32768    ; .text in IRAM, all 32 KB
+    custom_limit_flash = 1044464  ; .irom0.text + initialised data, the sketch space
+
+`pio run -t memreport` adds the largest symbols per region.  Standalone:
+
+    python3 scripts/size_report.py firmware.elf [--symbols N] [--nm xtensa-lx106-elf-nm]
+"""
+import argparse
+import subprocess
+import sys
+
+# ESP8266 address map
+REGIONS = [
+    ("DRAM", 0x3FFE8000, 0x40000000),
+    ("IRAM", 0x40100000, 0x40110000),
+    ("FLASH", 0x40200000, 0x40400000),
+]
+
+DRAM_SECTIONS = (".data", ".rodata", ".bss", ".noinit")
+IRAM_SECTIONS = (".iram0.text", ".text", ".text1")
+FLASH_SECTIONS = (".irom0.text", ".data", ".rodata", ".iram0.text", ".text", ".text1")
+
+
+def read_sections(elf, size_tool):
+    out = subprocess.check_output([size_tool, "-A", elf], universal_newlines=True)
+    sections = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 3 and parts[0].startswith(".") and parts[1].isdigit():
+            sections[parts[0]] = int(parts[1])
+    return sections
+
+
+def region_of(address):
+    for name, start, end in REGIONS:
+        if start <= address < end:
+            return name
+    return None
+
+
+def read_symbols(elf, nm_tool):
+    out = subprocess.check_output([nm_tool, "-S", "-C", "--size-sort", elf], universal_newlines=True)
+    symbols = {name: [] for name, _, _ in REGIONS}
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) < 4:
+            continue
+        address, size, kind, name = int(parts[0], 16), int(parts[1], 16), parts[2], parts[3]
+        region = region_of(address)
+        if region:
+            symbols[region].append((size, kind, name))
+    return symbols
+
+
+def usage(sections):
+    return {
+        "DRAM": sum(sections.get(s, 0) for s in DRAM_SECTIONS),
+        "IRAM": sum(sections.get(s, 0) for s in IRAM_SECTIONS),
+        "FLASH": sum(sections.get(s, 0) for s in FLASH_SECTIONS),
+    }
+
+
+def report(elf, size_tool, nm_tool, limits, top):
+    sections = read_sections(elf, size_tool)
+    used = usage(sections)
+
+    print("Memory budget for %s" % elf)
+    for name in sorted(sections):
+        if sections[name] and name in FLASH_SECTIONS + DRAM_SECTIONS:
+            print("  %-16s %8d" % (name, sections[name]))
+
+    failed = False
+    for region in ("DRAM", "IRAM", "FLASH"):
+        limit = limits.get(region)
+        line = "  %-5s %8d" % (region, used[region])
+        if limit:
+            line += " / %d (%d free)" % (limit, limit - used[region])
+            if used[region] > limit:
+                line += "  OVER BUDGET"
+                failed = True
+        print(line)
+
+    if top:
+        symbols = read_symbols(elf, nm_tool)
+        for region in ("DRAM", "IRAM", "FLASH"):
+            print("Largest %s symbols:" % region)
+            for size, kind, name in sorted(symbols[region], reverse=True)[:top]:
+                print("  %7d %s %s" % (size, kind, name))
+
+    return 1 if failed else 0
+
+
+def tool_from_gcc(gcc, tool):
+    # xtensa-lx106-elf-gcc -> xtensa-lx106-elf-nm
+    return gcc[: -len("gcc")] + tool if gcc.endswith("gcc") else tool
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="ESP8266 memory budget report")
+    parser.add_argument("elf")
+    parser.add_argument("--symbols", type=int, default=15)
+    parser.add_argument("--size", default="xtensa-lx106-elf-size")
+    parser.add_argument("--nm", default="xtensa-lx106-elf-nm")
+    parser.add_argument("--dram", type=int)
+    parser.add_argument("--iram", type=int)
+    parser.add_argument("--flash", type=int)
+    args = parser.parse_args()
+    limits = {"DRAM": args.dram, "IRAM": args.iram, "FLASH": args.flash}
+    sys.exit(report(args.elf, args.size, args.nm, limits, args.symbols))
+elif "Import" in globals():
+    # running as a PlatformIO extra script (not imported by display_bench.py)
+    Import("env")  # noqa: F821 - provided by PlatformIO
+
+    def limit(name):
+        value = env.GetProjectOption("custom_limit_" + name, "")  # noqa: F821
+        return int(value) if value else None
+
+    limits = {"DRAM": limit("dram"), "IRAM": limit("iram"), "FLASH": limit("flash")}
+    elf = "$BUILD_DIR/${PROGNAME}.elf"
+
+    def tools():
+        gcc = env.subst("$CC")  # noqa: F821
+        return env.subst("$SIZETOOL") or tool_from_gcc(gcc, "size"), tool_from_gcc(gcc, "nm")  # noqa: F821
+
+    def check_budget(target, source, env):
+        size_tool, nm_tool = tools()
+        return report(env.subst(elf), size_tool, nm_tool, limits, 0)
+
+    def full_report(target, source, env):
+        size_tool, nm_tool = tools()
+        return report(env.subst(elf), size_tool, nm_tool, limits, 25)
+
+    env.AddPostAction(elf, check_budget)  # noqa: F821
+    env.AddCustomTarget(  # noqa: F821
+        name="memreport",
+        dependencies=elf,
+        actions=[full_report],
+        title="Memory report",
+        description="Per-section and per-symbol memory use with budget check",
+    )
@@ -0,0 +1,155 @@
+"""
+@file trace_report.py
+@brief Input-to-display latency per screen from an input trace
+
+A build with -D INPUT_TRACE (env:trace) records encoder steps, button
+edges and every frame that changed the picture (see include/inputTrace.h)
+and writes them as TRACE lines when the memory page is opened (triple
+click) or a replay finishes.  Capture those with `pio device monitor`
+into a file, then:
+
+    python3 scripts/trace_report.py session.log
+    python3 scripts/trace_report.py session.log --baseline before.log --max-p99 120
+
+An input is answered by the first changed frame that started after it; the
+latency is from the input to the end of that frame's flush.  For the button
+the release counts, since that's when Button2 decides what the press was.
+Inputs that no frame answered within a second are listed as "no change" -
+those are the missed presses.  --max-p99 (ms) makes it exit 1 when any
+screen is over, so it can gate a change.
+
+    python3 scripts/trace_report.py session.log --header replayTrace.h
+
+writes the inputs as a PROGMEM table for -D INPUT_REPLAY.  As a PlatformIO
+pre: script it does that for the file named by custom_replay_trace (see
+env:trace_replay), so a replay build feeds the session back in.
+"""
+import os
+import sys
+
+# PlatformIO runs pre: scripts from the project directory, without __file__
+sys.path.insert(0, os.path.dirname(os.path.abspath(globals().get("__file__", "scripts/trace_report.py"))))
+from gen_util import write_if_changed  # noqa: E402
+
+ANSWER_WINDOW_US = 1000000
+
+
+def parse(lines):
+    # the last complete TRACE block: (screen names, [(us, kind, value, screen)])
+    screens, events, done = {}, [], None
+    for line in lines:
+        start = line.find("TRACE ")
+        if start < 0:
+            continue
+        fields = line[start:].split()
+        if fields[1] == "begin":
+            screens, events = {}, []
+        elif fields[1] == "end":
+            done = (screens, events)
+        elif fields[1] == "screen":
+            screens[int(fields[2])] = fields[3]
+        elif len(fields) == 5:
+            events.append((int(fields[1]), fields[2], int(fields[3]), int(fields[4])))
+    if done is None:
+        raise ValueError("no complete TRACE block")
+    return done
+
+
+def latencies(screens, events):
+    # {screen name: [latency us]}, and the inputs nothing answered
+    frames = [(us - value, us, screen) for us, kind, value, screen in events if kind == "F"]
+    inputs = [(us, kind) for us, kind, value, _ in events
+              if kind == "E" or (kind == "B" and value == 1)]
+    result, missed = {}, []
+    for us, kind in inputs:
+        answer = next((f for f in frames if f[0] >= us), None)
+        if answer is None or answer[1] - us > ANSWER_WINDOW_US:
+            missed.append((us, kind))
+            continue
+        name = screens.get(answer[2], str(answer[2]))
+        result.setdefault(name, []).append(answer[1] - us)
+    return result, missed
+
+
+def percentile(values, p):
+    # nearest rank
+    ordered = sorted(values)
+    return ordered[max(0, min(len(ordered) - 1, -(-len(ordered) * p // 100) - 1))]
+
+
+def summary(path):
+    with open(path, errors="replace") as f:
+        screens, events = parse(f)
+    result, missed = latencies(screens, events)
+    return {name: (len(v), percentile(v, 50), percentile(v, 99), max(v)) for name, v in result.items()}, missed
+
+
+def report(path, baseline=None, max_p99_ms=None):
+    stats, missed = summary(path)
+    before = summary(baseline)[0] if baseline else {}
+    print("%-12s %6s %9s %9s %9s%s" % ("screen", "inputs", "p50 ms", "p99 ms", "max ms",
+                                      "   p50/p99 vs baseline" if baseline else ""))
+    failed = False
+    for name in sorted(stats):
+        n, p50, p99, worst = stats[name]
+        line = "%-12s %6d %9.1f %9.1f %9.1f" % (name, n, p50 / 1000.0, p99 / 1000.0, worst / 1000.0)
+        if name in before:
+            line += "   %+8.1f %+8.1f" % ((p50 - before[name][1]) / 1000.0, (p99 - before[name][2]) / 1000.0)
+        if max_p99_ms is not None and p99 / 1000.0 > max_p99_ms:
+            line += "   OVER"
+            failed = True
+        print(line)
+    for us, kind in missed:
+        print("no change after %s at %.3f s" % ("encoder" if kind == "E" else "button", us / 1e6))
+    return 1 if failed else 0
+
+
+def header(path):
+    with open(path, errors="replace") as f:
+        _, events = parse(f)
+    inputs = [(us, kind, value) for us, kind, value, _ in events if kind in "EB"]
+    out = [
+        "// Generated by scripts/trace_report.py from %s - do not edit" % os.path.basename(path),
+        "#pragma once",
+        "",
+        '#include "inputTrace.h"',
+        "",
+        "#define REPLAY_TRACE_COUNT %d" % len(inputs),
+        "static const InputEvent REPLAY_TRACE[REPLAY_TRACE_COUNT + 1] PROGMEM = {",
+    ]
+    out += ["    {%du, %du, '%s', 0}," % (us, value & 0xFFFF, kind) for us, kind, value in inputs]
+    out += ["    {0, 0, 0, 0},", "};", ""]
+    return "\n".join(out)
+
+
+def write_header(source, target):
+    write_if_changed(target, header(source))
+
+
+def option(args, name):
+    if name in args:
+        return args[args.index(name) + 1]
+    return None
+
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    if not args or args[0].startswith("-"):
+        sys.exit(__doc__)
+    if option(args, "--header"):
+        write_header(args[0], option(args, "--header"))
+        sys.exit(0)
+    limit = option(args, "--max-p99")
+    sys.exit(report(args[0], option(args, "--baseline"), float(limit) if limit else None))
+elif "Import" in globals():
+    Import("env")  # noqa: F821 - provided by PlatformIO
+
+    trace = env.GetProjectOption("custom_replay_trace", "")  # noqa: F821
+    if trace:
+        source = os.path.join(env.subst("$PROJECT_DIR"), trace)  # noqa: F821
+        if not os.path.exists(source):
+            sys.stderr.write("trace_report: custom_replay_trace %s not found, capture one with env:trace\n" % trace)
+            env.Exit(1)  # noqa: F821
+        generated = os.path.join(env.subst("$BUILD_DIR"), "generated")  # noqa: F821
+        write_header(source, os.path.join(generated, "replayTrace.h"))
+        env.Append(CPPPATH=[generated])  # noqa: F821
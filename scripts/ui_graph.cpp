@@ -0,0 +1,321 @@
+/**
+ * @file ui_graph.cpp
+ * @brief Host check of the UI state chart (include/uiChart.h)
+ *
+ * Links src/uiChart.cpp against stub actions that only log their names,
+ * then:
+ *   - writes the chart's graph to stdout in Graphviz dot
+ *   - checks every screen can be reached from the splash, and the menu
+ *     from every screen
+ *   - walks a few sessions event by event, checking the state and the
+ *     enter/exit/transition actions taken on the way
+ * Exits non-zero, with the reason on stderr, if anything is off.
+ *
+ *     c++ -std=c++17 -O2 -Iscripts/host -Iinclude scripts/ui_graph.cpp src/uiChart.cpp -o ui_graph
+ *     ./ui_graph > ui.dot && dot -Tsvg ui.dot -o ui.svg
+ */
+#include <cstdio>
+#include <string>
+
+#include "uiChart.h"
+
+static std::string s_log;
+static uint8_t s_menu = START_TIMER;
+static bool s_resumePending = false;
+static bool s_newPreset = false;
+static bool s_crashed = false;
+
+bool menuAt(uint8_t item) { return s_menu == item; }
+bool resumePending(uint8_t) { return s_resumePending; }
+bool presetIsNew(uint8_t) { return s_newPreset; }
+bool resetCrashed(uint8_t) { return s_crashed; }
+
+#define ACTION(name) \
+    void name() { s_log += #name " "; }
+
+ACTION(splashEnter)
+ACTION(cycleEnter)
+ACTION(cycleExit)
+ACTION(settingsExit)
+ACTION(setTimerEnter)
+ACTION(editPresetEnter)
+ACTION(setTempEnter)
+ACTION(contrastEnter)
+ACTION(cleanerModeEnter)
+ACTION(memoryEnter)
+ACTION(diagnosticsEnter)
+ACTION(toggleBacklight)
+ACTION(setTimerUse)
+ACTION(editPresetSave)
+ACTION(setTempSave)
+ACTION(cleanerModeSave)
+ACTION(resumeAccept)
+ACTION(resumeDecline)
+ACTION(cycleStart)
+ACTION(cycleFinished)
+ACTION(cycleStopped)
+ACTION(historyEnter)
+ACTION(delayedArm)
+ACTION(lastResetEnter)
+ACTION(delayedHeat)
+
+// run actions and encoder steps: too many calls to be worth logging
+void splashRun() {}
+void displayMenu() {}
+void setTimerRun() {}
+void editPresetRun() {}
+void setTempRun() {}
+void contrastRun() {}
+void cleanerModeRun() {}
+void memoryRun() {}
+void diagnosticsRun() {}
+void energyRun() {}
+void historyRun() {}
+void lastResetRun() {}
+void resumeRun() {}
+void readyInRun() {}
+void delayedRun() {}
+void timerRun() {}
+void menuNext() { s_menu = (s_menu + 1) % MENU_ITEMS_COUNT; }
+void menuPrevious() { s_menu = (s_menu + MENU_ITEMS_COUNT - 1) % MENU_ITEMS_COUNT; }
+void setTimerNext() {}
+void setTimerPrevious() {}
+void editPresetIncrement() {}
+void editPresetDecrement() {}
+void editPresetNextField() {}
+void setTempIncrement() {}
+void setTempDecrement() {}
+void setTempNextDigit() {}
+void contrastUp() {}
+void contrastDown() {}
+void cleanerModeNext() {}
+void cleanerModePrevious() {}
+void diagnosticsScrollUp() {}
+void diagnosticsScrollDown() {}
+void historyOlder() {}
+void historyNewer() {}
+void readyInIncrement() {}
+void lastResetScrollUp() {}
+void lastResetScrollDown() {}
+void readyInDecrement() {}
+
+struct StdOut
+{
+    void print(const char *text) { fputs(text, stdout); }
+    void print(unsigned value) { printf("%u", value); }
+};
+
+static int s_failures = 0;
+
+static void fail(const char *what, const char *detail)
+{
+    fprintf(stderr, "FAIL %s: %s\n", what, detail);
+    s_failures++;
+}
+
+/// States an event can lead to from `state`, whatever the guards say
+template <class F>
+static void successors(uint8_t state, F f)
+{
+    for (uint8_t e = 0; e < EV_COUNT; e++)
+    {
+        uint8_t i = UI_CHART.first[state][e];
+        if (i == UiChart::NONE)
+        {
+            continue;
+        }
+        const uint8_t from = UI_CHART.transitions[i].from;
+        for (; i < UI_CHART.transitionCount && UI_CHART.transitions[i].from == from &&
+               UI_CHART.transitions[i].event == e;
+             i++)
+        {
+            const uint8_t to = UI_CHART.transitions[i].to;
+            f(to == NO_STATE ? state : to);
+        }
+    }
+}
+
+static bool isParent(uint8_t state)
+{
+    for (uint8_t s = 0; s < ST_COUNT; s++)
+    {
+        if (UI_CHART.states[s].parent == state)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool reaches(uint8_t from, uint8_t to)
+{
+    bool seen[ST_COUNT] = {};
+    uint8_t queue[ST_COUNT];
+    uint8_t head = 0, tail = 0;
+    queue[tail++] = from;
+    seen[from] = true;
+    while (head < tail)
+    {
+        const uint8_t s = queue[head++];
+        if (s == to)
+        {
+            return true;
+        }
+        successors(s, [&](uint8_t next)
+        {
+            if (!seen[next])
+            {
+                seen[next] = true;
+                queue[tail++] = next;
+            }
+        });
+    }
+    return false;
+}
+
+static void checkGraph()
+{
+    for (uint8_t s = 0; s < ST_COUNT; s++)
+    {
+        if (isParent(s) && UI_CHART.states[s].run == nullptr)
+        {
+            continue; // only ever a container
+        }
+        if (!reaches(ST_SPLASH, s))
+        {
+            fail("unreachable", UI_CHART.states[s].name);
+        }
+        if (s != ST_SPLASH && !reaches(s, ST_MENU))
+        {
+            fail("no way back to the menu", UI_CHART.states[s].name);
+        }
+    }
+}
+
+using Machine = StateMachine<UiChart>;
+
+static void expect(Machine &ui, const char *step, uint8_t state, const char *log)
+{
+    if (ui.state() != state)
+    {
+        char detail[96];
+        snprintf(detail, sizeof(detail), "in %s, expected %s", UI_CHART.states[ui.state()].name,
+                 UI_CHART.states[state].name);
+        fail(step, detail);
+    }
+    if (s_log != log)
+    {
+        fail(step, ("actions \"" + s_log + "\", expected \"" + log + "\"").c_str());
+    }
+    s_log.clear();
+}
+
+static void walk()
+{
+    Machine ui(UI_CHART);
+
+    ui.start(ST_SPLASH);
+    expect(ui, "boot", ST_SPLASH, "splashEnter ");
+    ui.post(EV_BOOTED);
+    ui.run();
+    expect(ui, "booted", ST_MENU, "");
+
+    // a long press anywhere but on "Start Timer" only switches the backlight
+    ui.dispatch(EV_DOWN);
+    ui.dispatch(EV_DOWN);
+    ui.dispatch(EV_HOLD);
+    expect(ui, "hold on Presets", ST_MENU, "toggleBacklight ");
+
+    // settings are saved once, on the way back to the menu
+    ui.dispatch(EV_CLICK);
+    expect(ui, "open presets", ST_SET_TIMER, "setTimerEnter ");
+    ui.dispatch(EV_HOLD);
+    expect(ui, "edit preset", ST_EDIT_PRESET, "editPresetEnter ");
+    ui.dispatch(EV_HOLD);
+    expect(ui, "save preset", ST_SET_TIMER, "editPresetSave ");
+    ui.dispatch(EV_DOUBLE); // nothing in settings takes a double click
+    expect(ui, "double in presets", ST_SET_TIMER, "");
+    ui.dispatch(EV_CLICK);
+    expect(ui, "use preset", ST_MENU, "setTimerUse settingsExit ");
+
+    // any press leaves an info page, the energy summary also times out
+    ui.dispatch(EV_TRIPLE);
+    expect(ui, "memory", ST_MEMORY, "memoryEnter ");
+    ui.dispatch(EV_HOLD);
+    expect(ui, "leave memory", ST_MENU, "");
+
+    // a run, from the menu and back
+    ui.dispatch(EV_UP);
+    ui.dispatch(EV_UP);
+    ui.dispatch(EV_HOLD);
+    expect(ui, "start", ST_TIMER, "cycleStart cycleEnter ");
+    ui.dispatch(EV_CLICK);
+    expect(ui, "click while running", ST_TIMER, "");
+    ui.post(EV_CYCLE_DONE);
+    ui.run();
+    expect(ui, "finished", ST_ENERGY, "cycleFinished cycleExit ");
+    hostMicros += (ENERGY_SUMMARY_MS - 1) * 1000UL;
+    ui.run();
+    expect(ui, "summary shown", ST_ENERGY, "");
+    hostMicros += 1000;
+    ui.run();
+    expect(ui, "summary timed out", ST_MENU, "");
+
+    // a delayed start waits, heaters off, then runs like any other
+    ui.dispatch(EV_DOWN);
+    ui.dispatch(EV_CLICK);
+    expect(ui, "ready in", ST_READY_IN, "");
+    ui.dispatch(EV_CLICK);
+    expect(ui, "armed", ST_DELAYED, "delayedArm ");
+    ui.dispatch(EV_CLICK);
+    expect(ui, "click while waiting", ST_DELAYED, "");
+    ui.post(EV_HEAT);
+    ui.run();
+    expect(ui, "heat", ST_TIMER, "delayedHeat cycleEnter ");
+    ui.dispatch(EV_HOLD);
+    expect(ui, "stop delayed", ST_ENERGY, "cycleStopped cycleExit ");
+    ui.dispatch(EV_CLICK);
+    ui.dispatch(EV_UP);
+    expect(ui, "back on start", ST_MENU, "");
+
+    // a checkpoint at boot offers the resume; a click carries on
+    Machine resumed(UI_CHART);
+    s_resumePending = true;
+    resumed.start(ST_SPLASH);
+    resumed.post(EV_BOOTED);
+    resumed.run();
+    expect(resumed, "resume offered", ST_RESUME, "splashEnter ");
+    resumed.dispatch(EV_CLICK);
+    expect(resumed, "resumed", ST_TIMER, "resumeAccept cycleEnter ");
+    resumed.dispatch(EV_HOLD);
+    expect(resumed, "stopped", ST_ENERGY, "cycleStopped cycleExit ");
+
+    // after a crash the boot shows what led up to it, unless there's a run to resume
+    Machine crashed(UI_CHART);
+    s_resumePending = false;
+    s_crashed = true;
+    crashed.start(ST_SPLASH);
+    crashed.post(EV_BOOTED);
+    crashed.run();
+    expect(crashed, "crash shown", ST_LAST_RESET, "splashEnter lastResetEnter ");
+    crashed.dispatch(EV_CLICK);
+    expect(crashed, "crash dismissed", ST_MENU, "");
+    crashed.dispatch(EV_DOUBLE);
+    crashed.dispatch(EV_CLICK);
+    expect(crashed, "from diagnostics", ST_LAST_RESET, "diagnosticsEnter lastResetEnter ");
+}
+
+int main()
+{
+    StdOut out;
+    UI_CHART.dump(out, "ui");
+    checkGraph();
+    walk();
+    if (s_failures)
+    {
+        fprintf(stderr, "%d failures\n", s_failures);
+        return 1;
+    }
+    fprintf(stderr, "%u states, %u transitions: ok\n", ST_COUNT, UI_CHART.transitionCount);
+    return 0;
+}
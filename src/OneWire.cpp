@@ -0,0 +1,436 @@
+/**
+ * @file OneWire.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief 1-Wire bus master tuned for the ESP8266's GPIO16
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Only the slot level code is in IRAM - a flash cache miss inside an
+ * interrupts-off window would stretch it.  Between slots the timing is
+ * loose (recovery can be as long as it likes), so bytes, search and the
+ * CRCs stay in flash.
+ */
+#include "OneWire.h"
+
+#ifndef ONEWIRE_STOCK // the stock library is linked instead
+
+// standard speed slot timings, us
+static constexpr uint32_t RESET_LOW_US = 480;
+static constexpr uint32_t PRESENCE_SAMPLE_US = 70;  // after release
+static constexpr uint32_t PRESENCE_LATE_US = 75;    // an early, short pulse may be over
+static constexpr uint32_t RESET_RECOVERY_US = 410;
+static constexpr uint32_t BUS_HIGH_TIMEOUT_US = 250;
+static constexpr uint8_t RESET_TRIES = 3;
+static constexpr uint32_t ONE_LOW_US = 5;      // 1..15
+static constexpr uint32_t ZERO_LOW_US = 65;    // 60..120
+static constexpr uint32_t READ_LOW_US = 2;     // >= 1
+static constexpr uint32_t READ_SAMPLE_US = 10; // from the fall, < 15
+static constexpr uint32_t SLOT_US = 70;        // slot plus recovery
+
+static OneWireStats s_stats = {};
+
+void OneWire::begin(uint8_t pin)
+{
+    _pin = pin;
+    _gpio16 = pin == 16;
+    _mask = _gpio16 ? 1 : 1 << pin;
+    _cyclesPerUs = ESP.getCpuFreqMHz();
+    pinMode(pin, INPUT); // GPIO function, released; the pull-up is on the board
+    if (_gpio16)
+    {
+        GP16O &= ~1;
+    }
+    else
+    {
+        GPOC = _mask;
+    }
+    _powered = false;
+}
+
+inline void IRAM_ATTR OneWire::low()
+{
+    if (_gpio16)
+    {
+        if (_powered)
+        {
+            GP16O &= ~1;
+            _powered = false;
+        }
+        GP16E |= 1;
+    }
+    else
+    {
+        if (_powered)
+        {
+            GPOC = _mask;
+            _powered = false;
+        }
+        GPES = _mask;
+    }
+}
+
+inline void IRAM_ATTR OneWire::release()
+{
+    if (_gpio16)
+    {
+        GP16E &= ~1;
+    }
+    else
+    {
+        GPEC = _mask;
+    }
+}
+
+inline uint8_t IRAM_ATTR OneWire::level() const
+{
+    return _gpio16 ? GP16I & 1 : (GPI & _mask) != 0;
+}
+
+inline uint32_t IRAM_ATTR OneWire::irqOff()
+{
+    uint32_t state = xt_rsil(15);
+    _irqOffAt = ESP.getCycleCount();
+    return state;
+}
+
+inline void IRAM_ATTR OneWire::irqOn(uint32_t state)
+{
+    uint32_t cycles = ESP.getCycleCount() - _irqOffAt;
+    xt_wsr_ps(state);
+    s_stats.irqOffCycles += cycles;
+    s_stats.maxIrqOffCycles = max(s_stats.maxIrqOffCycles, cycles);
+}
+
+inline void IRAM_ATTR OneWire::waitUs(uint32_t fromCycles, uint32_t us) const
+{
+    const uint32_t cycles = us * _cyclesPerUs;
+    while (ESP.getCycleCount() - fromCycles < cycles)
+    {
+    }
+}
+
+uint8_t IRAM_ATTR OneWire::reset()
+{
+    s_stats.resets++;
+    depower();
+    release();
+
+    // a device may still be holding the line from an interrupted slot
+    uint32_t start = ESP.getCycleCount();
+    while (!level())
+    {
+        if (ESP.getCycleCount() - start > BUS_HIGH_TIMEOUT_US * _cyclesPerUs)
+        {
+            return 0;
+        }
+    }
+
+    for (uint8_t tries = 0; tries < RESET_TRIES; tries++)
+    {
+        // a longer low is still a reset, so interrupts can stretch it
+        start = ESP.getCycleCount();
+        low();
+        waitUs(start, RESET_LOW_US);
+        release();
+
+        // presence: low from 15-60us after release, for 60-240us - only
+        // 60-75us is low for every device
+        const uint32_t released = ESP.getCycleCount();
+        waitUs(released, PRESENCE_SAMPLE_US);
+        const uint8_t present = !level();
+        const uint32_t sampledAt = ESP.getCycleCount() - released;
+        waitUs(released, PRESENCE_SAMPLE_US + RESET_RECOVERY_US);
+        if (sampledAt < PRESENCE_LATE_US * _cyclesPerUs)
+        {
+            return present;
+        }
+        // an interrupt held the sample past the pulse; ask again
+    }
+    return 0;
+}
+
+void IRAM_ATTR OneWire::write_bit(uint8_t bit)
+{
+    // an interrupt inside the low of a 1 bit turns it into a 0, and one
+    // inside a 0 bit's low can push it past 120us, where it is no bit at all
+    const uint32_t state = irqOff();
+    const uint32_t start = ESP.getCycleCount();
+    low();
+    waitUs(start, (bit & 1) ? ONE_LOW_US : ZERO_LOW_US);
+    release();
+    irqOn(state);
+    if (bit & 1)
+    {
+        s_stats.ones++;
+    }
+    else
+    {
+        s_stats.zeros++;
+    }
+    waitUs(start, SLOT_US);
+}
+
+uint8_t IRAM_ATTR OneWire::read_bit()
+{
+    const uint32_t state = irqOff();
+    const uint32_t start = ESP.getCycleCount();
+    low();
+    waitUs(start, READ_LOW_US);
+    release();
+    waitUs(start, READ_SAMPLE_US);
+    const uint8_t bit = level();
+    irqOn(state);
+    s_stats.reads++;
+    waitUs(start, SLOT_US);
+    return bit;
+}
+
+void OneWire::write(uint8_t value, uint8_t power)
+{
+    for (uint8_t mask = 0x01; mask; mask <<= 1)
+    {
+        write_bit(value & mask);
+    }
+    if (power)
+    {
+        // strong pull-up for parasite powered devices
+        if (_gpio16)
+        {
+            GP16O |= 1;
+            GP16E |= 1;
+        }
+        else
+        {
+            GPOS = _mask;
+            GPES = _mask;
+        }
+        _powered = true;
+    }
+}
+
+void OneWire::write_bytes(const uint8_t *buffer, uint16_t count, bool power)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        write(buffer[i]);
+    }
+    if (power)
+    {
+        write(0xFF, 1); // nothing listens to a trailing all-ones byte
+    }
+}
+
+uint8_t OneWire::read()
+{
+    uint8_t value = 0;
+    for (uint8_t mask = 0x01; mask; mask <<= 1)
+    {
+        if (read_bit())
+        {
+            value |= mask;
+        }
+    }
+    return value;
+}
+
+void OneWire::read_bytes(uint8_t *buffer, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        buffer[i] = read();
+    }
+}
+
+void OneWire::select(const uint8_t rom[8])
+{
+    write(0x55); // MATCH ROM
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        write(rom[i]);
+    }
+}
+
+void OneWire::skip()
+{
+    write(0xCC); // SKIP ROM
+}
+
+void OneWire::depower()
+{
+    if (!_powered)
+    {
+        return;
+    }
+    release();
+    if (_gpio16)
+    {
+        GP16O &= ~1;
+    }
+    else
+    {
+        GPOC = _mask;
+    }
+    _powered = false;
+}
+
+void OneWire::reset_search()
+{
+    _lastDiscrepancy = 0;
+    _lastFamilyDiscrepancy = 0;
+    _lastDevice = false;
+    memset(_rom, 0, sizeof(_rom));
+}
+
+void OneWire::target_search(uint8_t familyCode)
+{
+    memset(_rom, 0, sizeof(_rom));
+    _rom[0] = familyCode;
+    _lastDiscrepancy = 64;
+    _lastFamilyDiscrepancy = 0;
+    _lastDevice = false;
+}
+
+// Maxim application note 187
+bool OneWire::search(uint8_t *newAddr, bool searchMode)
+{
+    uint8_t bitNumber = 1;
+    uint8_t lastZero = 0;
+    uint8_t romByte = 0;
+    uint8_t romMask = 1;
+    bool found = false;
+
+    if (!_lastDevice)
+    {
+        if (!reset())
+        {
+            reset_search();
+            return false;
+        }
+        write(searchMode ? 0xF0 : 0xEC); // SEARCH ROM : ALARM SEARCH
+
+        while (romByte < 8)
+        {
+            const uint8_t bit = read_bit();
+            const uint8_t complement = read_bit();
+            if (bit && complement)
+            {
+                break; // nobody answered
+            }
+
+            uint8_t direction;
+            if (bit != complement)
+            {
+                direction = bit; // every device left agrees
+            }
+            else
+            {
+                if (bitNumber < _lastDiscrepancy)
+                {
+                    direction = (_rom[romByte] & romMask) != 0;
+                }
+                else
+                {
+                    direction = bitNumber == _lastDiscrepancy;
+                }
+                if (!direction)
+                {
+                    lastZero = bitNumber;
+                    if (lastZero < 9)
+                    {
+                        _lastFamilyDiscrepancy = lastZero;
+                    }
+                }
+            }
+
+            if (direction)
+            {
+                _rom[romByte] |= romMask;
+            }
+            else
+            {
+                _rom[romByte] &= ~romMask;
+            }
+            write_bit(direction);
+
+            bitNumber++;
+            romMask <<= 1;
+            if (!romMask)
+            {
+                romByte++;
+                romMask = 1;
+            }
+        }
+
+        if (bitNumber > 64)
+        {
+            _lastDiscrepancy = lastZero;
+            _lastDevice = _lastDiscrepancy == 0;
+            found = true;
+        }
+    }
+
+    if (!found || !_rom[0])
+    {
+        reset_search();
+        return false;
+    }
+    memcpy(newAddr, _rom, sizeof(_rom));
+    return true;
+}
+
+uint8_t OneWire::crc8(const uint8_t *data, uint8_t length)
+{
+    uint8_t crc = 0;
+    while (length--)
+    {
+        uint8_t in = *data++;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            const uint8_t mix = (crc ^ in) & 0x01;
+            crc >>= 1;
+            if (mix)
+            {
+                crc ^= 0x8C;
+            }
+            in >>= 1;
+        }
+    }
+    return crc;
+}
+
+uint16_t OneWire::crc16(const uint8_t *input, uint16_t length, uint16_t crc)
+{
+    static const uint8_t ODD_PARITY[16] = {0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0};
+    for (uint16_t i = 0; i < length; i++)
+    {
+        uint16_t data = (input[i] ^ crc) & 0xFF;
+        crc >>= 8;
+        if (ODD_PARITY[data & 0x0F] ^ ODD_PARITY[data >> 4])
+        {
+            crc ^= 0xC001;
+        }
+        data <<= 6;
+        crc ^= data;
+        data <<= 1;
+        crc ^= data;
+    }
+    return crc;
+}
+
+bool OneWire::check_crc16(const uint8_t *input, uint16_t length, const uint8_t *invertedCrc, uint16_t crc)
+{
+    crc = ~crc16(input, length, crc);
+    return (crc & 0xFF) == invertedCrc[0] && (crc >> 8) == invertedCrc[1];
+}
+
+const OneWireStats &OneWire::stats()
+{
+    return s_stats;
+}
+
+void OneWire::resetStats()
+{
+    s_stats = {};
+}
+
+#endif // ONEWIRE_STOCK
@@ -0,0 +1,104 @@
+/**
+ * @file backlight.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Dimmable backlight, faded by a Ticker
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "backlight.h"
+#include "Ticker.h"
+
+static constexpr uint8_t SIGMA_DELTA_CHANNEL = 0;
+
+static Ticker s_fadeTicker;
+static uint8_t s_pin = 0;
+static bool s_modulated = false; // the pin is on the sigma-delta modulator
+static uint8_t s_level = 0;      // last sent to the hardware
+static uint8_t s_from = 0;
+static uint8_t s_target = 0;
+static uint32_t s_fadeStartMs = 0;
+static uint16_t s_fadeMs = 0;
+static uint32_t s_writes = 0;
+
+static void write(uint8_t level)
+{
+    if (level == s_level)
+    {
+        return;
+    }
+    s_level = level;
+    s_writes++;
+    if (level == 0 || level == BACKLIGHT_ON)
+    {
+        if (s_modulated)
+        {
+            sigmaDeltaDetachPin(s_pin);
+            s_modulated = false;
+        }
+        digitalWrite(s_pin, level ? HIGH : LOW);
+        return;
+    }
+    if (!s_modulated)
+    {
+        sigmaDeltaAttachPin(s_pin, SIGMA_DELTA_CHANNEL);
+        s_modulated = true;
+    }
+    // square law: the eye is far more sensitive to changes near dark
+    const uint8_t duty = (static_cast<uint16_t>(level) * level + 254) / 255;
+    sigmaDeltaWrite(SIGMA_DELTA_CHANNEL, duty);
+}
+
+static void fadeStep()
+{
+    const uint32_t elapsed = millis() - s_fadeStartMs;
+    if (elapsed >= s_fadeMs)
+    {
+        s_fadeTicker.detach();
+        write(s_target);
+        return;
+    }
+    const int16_t span = static_cast<int16_t>(s_target) - s_from;
+    write(s_from + static_cast<int32_t>(span) * static_cast<int32_t>(elapsed) / s_fadeMs);
+}
+
+void backlightBegin(uint8_t pin)
+{
+    s_pin = pin;
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    sigmaDeltaSetup(SIGMA_DELTA_CHANNEL, BACKLIGHT_SIGMA_DELTA_HZ);
+}
+
+void backlightFade(uint8_t level, uint16_t fadeMs)
+{
+    if (level == s_target)
+    {
+        return; // already there or on the way
+    }
+    s_target = level;
+    if (fadeMs == 0)
+    {
+        s_fadeTicker.detach();
+        write(level);
+        return;
+    }
+    s_from = s_level;
+    s_fadeStartMs = millis();
+    s_fadeMs = fadeMs;
+    s_fadeTicker.attach_ms(BACKLIGHT_FADE_STEP_MS, fadeStep);
+}
+
+uint8_t backlightLevel()
+{
+    return s_level;
+}
+
+uint8_t backlightTarget()
+{
+    return s_target;
+}
+
+uint32_t backlightWrites()
+{
+    return s_writes;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file bathChannel.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief One bath: its sensor, heater, cleaner and the run in progress
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "bathChannel.h"
+
+// {min on ms, min off ms, hysteresis F, max switches per minute}
+static const RelayConfig HEATER_RELAY = {5000, 5000, 1.0f, 6};     // SSR, heater element
+static const RelayConfig CLEANER_RELAY = {10000, 10000, 2.0f, 2}; // ultrasonic transducer
+static constexpr float RELAY_FILTER_S = 4.0f; // time constant of the reading the relays act on
+
+BathChannel::BathChannel(DallasTemperature &sensors, uint8_t sensorIndex, uint8_t heaterPin, uint8_t cleanerPin)
+    : _sampler(sensors, sensorIndex),
+      _heater(heaterPin, HEATER_RELAY),
+      _cleaner(cleanerPin, CLEANER_RELAY)
+{
+}
+
+void BathChannel::begin()
+{
+    _heater.begin();
+    _cleaner.begin();
+}
+
+bool BathChannel::beginSensor()
+{
+    return _sampler.begin();
+}
+
+void BathChannel::setReadyTemperature(float readyF)
+{
+    _readyF = readyF;
+    _sampler.setTarget(readyF);
+}
+
+void BathChannel::start(uint32_t seconds)
+{
+    resume(seconds * 1000);
+}
+
+void BathChannel::resume(uint32_t remainingMs)
+{
+    _startMs = millis();
+    _runMs = remainingMs;
+    _running = true;
+    _finished = false;
+}
+
+void BathChannel::stop()
+{
+    _heater.forceOff(millis());
+    _cleaner.forceOff(millis());
+    _running = false;
+    _coasting = false;
+    _etaS = -1;
+    _relayValid = false;
+    _reached = false;
+}
+
+uint32_t BathChannel::remainingMs() const
+{
+    if (!_running)
+    {
+        return 0;
+    }
+    uint32_t elapsed = millis() - _startMs;
+    return elapsed >= _runMs ? 0 : _runMs - elapsed;
+}
+
+uint64_t BathChannel::cleanerOnMicros() const
+{
+    if (_cleaner.pin() >= MODULATED_PIN_BASE)
+    {
+        return cleanerModOnMicros();
+    }
+    return _cleaner.onMicros();
+}
+
+long BathChannel::remainingSeconds() const
+{
+    return (remainingMs() + 999) / 1000;
+}
+
+void BathChannel::update()
+{
+    uint32_t now = millis();
+    if (_sampler.update())
+    {
+        _model.observe(now, _sampler.temperatureF(), _sampler.rateFPerMin() / 60.0f, _heater.isOn());
+    }
+    if (_running)
+    {
+        control(now);
+    }
+}
+
+void BathChannel::control(uint32_t nowMs)
+{
+    if (nowMs - _startMs >= _runMs)
+    {
+        stop();
+        _finished = true;
+        return;
+    }
+
+    if (!_sampler.valid())
+    {
+        // no reading yet (or no sensor): never heat blind
+        _heater.forceOff(nowMs);
+        _cleaner.forceOff(nowMs);
+        _etaS = -1;
+        _relayValid = false;
+        return;
+    }
+
+    float tempF = _sampler.temperatureF();
+    float rateFps = _sampler.rateFPerMin() / 60.0f;
+
+    // the relays act on a slower copy of the reading and its rate: a noisy
+    // sample at ready mustn't hand over to the cleaner (whose dwell and rate
+    // limit would then keep the heater out while the bath cools), and a
+    // noisy rate mustn't make the bath coast short of ready
+    if (!_relayValid)
+    {
+        _relayF = tempF;
+        _relayRateFps = rateFps;
+        _relayValid = true;
+    }
+    else
+    {
+        const float dt = (nowMs - _relayMs) / 1000.0f;
+        const float alpha = dt / (RELAY_FILTER_S + dt);
+        _relayF += alpha * (tempF - _relayF);
+        _relayRateFps += alpha * (rateFps - _relayRateFps);
+    }
+    _relayMs = nowMs;
+
+    // the relays hold each state for a minimum time and switch inside a
+    // hysteresis band, so noise on the reading can't chatter them.  On the
+    // way up, once the model knows the bath, the heater stops early and the
+    // bath coasts in; after that the band holds it.  Heater and cleaner
+    // never run together - the heater wins.
+    _reached = _reached || _relayF >= _readyF;
+    _coasting = !_reached && _model.shouldCoast(_relayF, _relayRateFps, _readyF);
+    const bool heat = !_coasting && _heater.wantBelow(_relayF, _readyF);
+    requestExclusive(_heater, heat, _cleaner, _cleaner.wantAbove(_relayF, _readyF), nowMs);
+    _etaS = _model.etaSeconds(tempF, _readyF, _heater.isOn());
+}
+
+BathPhase BathChannel::phase() const
+{
+    if (!_running)
+    {
+        return _finished ? PHASE_DONE : PHASE_IDLE;
+    }
+    if (!_sampler.valid())
+    {
+        return PHASE_NO_READING;
+    }
+    if (_cleaner.isOn())
+    {
+        return PHASE_CLEAN;
+    }
+    if (_heater.isOn())
+    {
+        return PHASE_HEAT;
+    }
+    return _coasting ? PHASE_COAST : PHASE_WAIT;
+}
+
+const char *BathChannel::status() const
+{
+    static const char *const words[] = {"idle", "--", "heat", "coast", "wait", "clean", "done"};
+    return words[phase()];
+}
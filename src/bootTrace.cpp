@@ -0,0 +1,43 @@
+/**
+ * @file bootTrace.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Timestamps for each stage of the boot
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "bootTrace.h"
+
+static BootStage s_stages[BOOT_TRACE_MAX];
+static uint8_t s_count = 0;
+
+void bootMark(const __FlashStringHelper *stage)
+{
+    if (s_count < BOOT_TRACE_MAX)
+    {
+        s_stages[s_count++] = {stage, static_cast<uint32_t>(micros())};
+    }
+}
+
+uint8_t bootStageCount()
+{
+    return s_count;
+}
+
+const BootStage &bootStage(uint8_t index)
+{
+    return s_stages[index];
+}
+
+uint32_t bootStageMicros(uint8_t index)
+{
+    return s_stages[index].endUs - (index ? s_stages[index - 1].endUs : 0);
+}
+
+void bootTracePrint(Print &out)
+{
+    for (uint8_t i = 0; i < s_count; i++)
+    {
+        out.printf("boot %8u us  (at %8u us)  ", bootStageMicros(i), s_stages[i].endUs);
+        out.println(s_stages[i].name);
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * @file cleanerMod.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Pulsed and swept sonication, timed by the hardware timer (timer1)
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * timer1 also drives analogWrite(), tone() and Servo; nothing else in this
+ * firmware uses them.
+ */
+#include "cleanerMod.h"
+
+static const CleanerMode MODES[] = {
+    // name          period  on from  on to  ramp  sweep
+    {"Continuous",   0,      0,       0,     0,    false},
+    {"Pulse 2/1",    3000,   2000,    2000,  0,    false},
+    {"Pulse 1/1",    2000,   1000,    1000,  0,    false},
+    {"Gentle",       1000,   300,     300,   0,    false},
+    {"Degas",        1000,   200,     1000,  20,   false},
+    {"Sweep",        1000,   300,     900,   10,   true},
+};
+static constexpr uint8_t MODE_COUNT = sizeof(MODES) / sizeof(MODES[0]);
+
+static uint8_t s_selected = 0;
+
+// Pattern state; written with the timer stopped, then only by the interrupt
+static uint8_t s_gpio = 0;
+static bool s_timed = false;      // timer1 is running a pattern
+static bool s_pinOn = false;
+static uint32_t s_periodUs = 0;
+static int32_t s_onUs = 0;        // on time of the current period
+static int32_t s_stepUs = 0;      // change per period while ramping
+static int32_t s_onFromUs = 0;
+static int32_t s_onToUs = 0;
+static uint8_t s_rampPeriods = 0;
+static uint8_t s_rampDone = 0;
+static bool s_sweep = false;
+static bool s_rampingDown = false;
+
+// Timing: the cycle counter is the reference, timer1 ticks at 80MHz / 256
+static uint32_t s_cyclesPerUs = 80;
+static uint8_t s_cyclesPerTickShift = 8; // CPU cycles per timer1 tick, as a shift
+static uint32_t s_dueCycles = 0;
+static volatile uint32_t s_edges = 0;
+static volatile uint32_t s_minLate = UINT32_MAX; // cycles
+static volatile uint32_t s_maxLate = 0;
+
+// Time the pin has been high, for the energy accounting
+static volatile uint64_t s_highUs = 0; // completed on parts
+static uint32_t s_riseCycles = 0;      // the current on part, when timed
+static uint64_t s_riseUs = 0;          // the current on part, when continuous
+
+static inline void IRAM_ATTR setPin(bool on)
+{
+    if (on)
+    {
+        GPOS = 1 << s_gpio;
+    }
+    else
+    {
+        GPOC = 1 << s_gpio;
+    }
+    s_pinOn = on;
+}
+
+// Arm timer1 for the next edge `us` after the one that was due now, taking
+// off however late this interrupt ran
+static inline void IRAM_ATTR armNext(uint32_t us, uint32_t lateCycles)
+{
+    s_dueCycles += us * s_cyclesPerUs;
+    uint32_t ticks = (us * 5) >> 4; // 0.3125 ticks per us
+    uint32_t lateTicks = lateCycles >> s_cyclesPerTickShift;
+    timer1_write(ticks > lateTicks + 10 ? ticks - lateTicks : 10);
+}
+
+// The next period's on time: along the ramp, then hold or turn back
+static inline void IRAM_ATTR nextPeriod()
+{
+    if (!s_rampPeriods || (!s_sweep && s_rampDone >= s_rampPeriods))
+    {
+        return;
+    }
+    s_onUs += s_rampingDown ? -s_stepUs : s_stepUs;
+    if (++s_rampDone >= s_rampPeriods)
+    {
+        s_onUs = s_rampingDown ? s_onFromUs : s_onToUs; // no rounding creep
+        if (s_sweep)
+        {
+            s_rampingDown = !s_rampingDown;
+            s_rampDone = 0;
+        }
+    }
+}
+
+static void IRAM_ATTR onEdge()
+{
+    uint32_t late = ESP.getCycleCount() - s_dueCycles;
+    if (late < s_minLate)
+    {
+        s_minLate = late;
+    }
+    if (late > s_maxLate)
+    {
+        s_maxLate = late;
+    }
+    s_edges = s_edges + 1;
+
+    if (s_pinOn)
+    {
+        s_highUs = s_highUs + s_onUs;
+        uint32_t offUs = s_periodUs - s_onUs;
+        if (offUs)
+        {
+            setPin(false);
+            armNext(offUs, late);
+            return;
+        }
+        // on for the whole period: straight into the next one
+    }
+    nextPeriod();
+    setPin(true);
+    s_riseCycles = s_dueCycles;
+    armNext(s_onUs, late);
+}
+
+// How long the pin has been high in the on part that's under way
+static uint32_t currentHighUs()
+{
+    if (!s_pinOn)
+    {
+        return 0;
+    }
+    if (s_timed)
+    {
+        return (ESP.getCycleCount() - s_riseCycles) / s_cyclesPerUs;
+    }
+    return micros64() - s_riseUs;
+}
+
+uint8_t cleanerModeCount()
+{
+    return MODE_COUNT;
+}
+
+const CleanerMode &cleanerMode(uint8_t index)
+{
+    return MODES[index < MODE_COUNT ? index : 0];
+}
+
+void cleanerModSelect(uint8_t index)
+{
+    s_selected = index < MODE_COUNT ? index : 0;
+}
+
+uint8_t cleanerModSelected()
+{
+    return s_selected;
+}
+
+void cleanerModWrite(uint8_t gpio, bool on)
+{
+    if (s_timed)
+    {
+        timer1_disable();
+        timer1_detachInterrupt();
+    }
+    s_highUs = s_highUs + currentHighUs();
+    s_timed = false;
+    s_gpio = gpio;
+    const CleanerMode &mode = MODES[s_selected];
+    if (!on || mode.periodMs == 0)
+    {
+        digitalWrite(gpio, on ? HIGH : LOW);
+        s_pinOn = on;
+        s_riseUs = micros64();
+        return;
+    }
+
+    s_periodUs = mode.periodMs * 1000UL;
+    s_onFromUs = mode.onStartMs * 1000L;
+    s_onToUs = mode.onEndMs * 1000L;
+    s_onUs = s_onFromUs;
+    s_rampPeriods = mode.rampPeriods;
+    s_stepUs = s_rampPeriods ? (s_onToUs - s_onFromUs) / s_rampPeriods : 0;
+    s_rampDone = 0;
+    s_rampingDown = false;
+    s_sweep = mode.sweep;
+
+    s_cyclesPerUs = ESP.getCpuFreqMHz();
+    s_cyclesPerTickShift = s_cyclesPerUs > 80 ? 9 : 8;
+    s_edges = 0;
+    s_minLate = UINT32_MAX;
+    s_maxLate = 0;
+
+    timer1_attachInterrupt(onEdge);
+    timer1_enable(TIM_DIV256, TIM_EDGE, TIM_SINGLE);
+    s_timed = true;
+    s_dueCycles = ESP.getCycleCount();
+    setPin(true);
+    s_riseCycles = s_dueCycles;
+    armNext(s_onUs, 0);
+}
+
+CleanerJitter cleanerModJitter()
+{
+    noInterrupts();
+    uint32_t edges = s_edges;
+    uint32_t minLate = s_minLate;
+    uint32_t maxLate = s_maxLate;
+    interrupts();
+    if (!edges)
+    {
+        return {0, 0, 0};
+    }
+    return {edges, static_cast<uint16_t>(min(minLate / s_cyclesPerUs, 65535U)),
+            static_cast<uint16_t>(min(maxLate / s_cyclesPerUs, 65535U))};
+}
+
+uint64_t cleanerModOnMicros()
+{
+    noInterrupts();
+    uint64_t highUs = s_highUs + currentHighUs();
+    interrupts();
+    return highUs;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file cycleHistory.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief A record of every cycle, kept in LittleFS, with an index
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "cycleHistory.h"
+#include "resume.h"
+#include "postMortem.h"
+#include <LittleFS.h>
+#include <time.h>
+
+static constexpr uint32_t MAGIC = 0x48535431; // 'HST1'
+
+static uint16_t recordCrc(const CycleRecord &record)
+{
+    return rtcCrc32(&record, offsetof(CycleRecord, crc)) & 0xFFFF;
+}
+
+static uint16_t fileRecords(const char *path)
+{
+    File file = LittleFS.open(path, "r");
+    if (!file)
+    {
+        return 0;
+    }
+    const uint16_t records = file.size() / sizeof(CycleRecord);
+    file.close();
+    return records;
+}
+
+// ---------------------------------------------------------------
+
+void CycleTracker::start(Preset preset, uint8_t channels)
+{
+    _preset = preset;
+    _startTime = time(nullptr);
+    _startMs = millis();
+    _toTempMs = 0;
+    _peakOverF = 0.0f;
+    _channels = channels;
+    _ready = 0;
+    _reached = false;
+}
+
+void CycleTracker::sample(uint8_t channel, float tempF, float readyF)
+{
+    if (tempF >= readyF)
+    {
+        _ready |= 1 << channel;
+        _peakOverF = max(_peakOverF, tempF - readyF);
+    }
+    if (!_reached && _ready == (1 << _channels) - 1)
+    {
+        _reached = true;
+        _toTempMs = millis() - _startMs;
+    }
+}
+
+CycleRecord CycleTracker::finish(CycleEnd end, const EnergyUse &energy) const
+{
+    CycleRecord record = {};
+    record.startTime = _startTime;
+    record.runS = min<uint32_t>((energy.runMs + 500) / 1000, UINT16_MAX);
+    record.toTempS = _reached ? min<uint32_t>((_toTempMs + 500) / 1000, HISTORY_NEVER - 1) : HISTORY_NEVER;
+    record.energyDWh = min(lroundf((energy.heaterWh() + energy.cleanerWh()) * 10), static_cast<long>(UINT16_MAX));
+    record.preset = _preset;
+    record.overshootDF = min(lroundf(_peakOverF * 10), 255L);
+    record.end = end;
+    return record;
+}
+
+// ---------------------------------------------------------------
+
+bool CycleHistory::begin()
+{
+    postMortemProbe(PROBE_LITTLEFS);
+    _mounted = LittleFS.begin();
+    if (!_mounted)
+    {
+        return false;
+    }
+
+    File file = LittleFS.open(HISTORY_INDEX, "r");
+    bool loaded = file && file.read(reinterpret_cast<uint8_t *>(&_index), sizeof(_index)) == sizeof(_index);
+    if (file)
+    {
+        file.close();
+    }
+    loaded = loaded && _index.magic == MAGIC &&
+             _index.crc == rtcCrc32(&_index, offsetof(Index, crc)) &&
+             _index.records[0] == fileRecords(HISTORY_CURRENT) &&
+             _index.records[1] == fileRecords(HISTORY_PREVIOUS);
+    return loaded || rebuild();
+}
+
+bool CycleHistory::add(CycleRecord &record)
+{
+    if (!_mounted)
+    {
+        return false;
+    }
+    postMortemProbe(PROBE_HISTORY_ADD);
+
+    if (_index.records[0] >= HISTORY_FILE_RECORDS)
+    {
+        // rotate: the current file becomes the previous one, the oldest goes
+        LittleFS.remove(HISTORY_PREVIOUS);
+        LittleFS.rename(HISTORY_CURRENT, HISTORY_PREVIOUS);
+        _index.records[1] = _index.records[0];
+        _index.records[0] = 0;
+    }
+
+    record.seq = _index.lastSeq + 1;
+    record.crc = recordCrc(record);
+    File file = LittleFS.open(HISTORY_CURRENT, "a");
+    if (!file)
+    {
+        return false;
+    }
+    const bool written = file.write(reinterpret_cast<const uint8_t *>(&record), sizeof(record)) == sizeof(record);
+    file.close();
+    if (!written)
+    {
+        return false;
+    }
+
+    _index.records[0]++;
+    account(record);
+    return saveIndex();
+}
+
+bool CycleHistory::read(uint16_t back, CycleRecord &record) const
+{
+    if (!_mounted || back >= count())
+    {
+        return false;
+    }
+    const char *path = HISTORY_CURRENT;
+    uint16_t records = _index.records[0];
+    if (back >= records)
+    {
+        back -= records;
+        path = HISTORY_PREVIOUS;
+        records = _index.records[1];
+    }
+
+    File file = LittleFS.open(path, "r");
+    if (!file)
+    {
+        return false;
+    }
+    const bool read = file.seek((records - 1 - back) * sizeof(CycleRecord), SeekSet) &&
+                      file.read(reinterpret_cast<uint8_t *>(&record), sizeof(record)) == sizeof(record);
+    file.close();
+    return read && record.crc == recordCrc(record);
+}
+
+const PresetStats *CycleHistory::stats(Preset preset) const
+{
+    for (const PresetStats &stats : _index.preset)
+    {
+        if (stats.cycles && stats.preset == preset)
+        {
+            return &stats;
+        }
+    }
+    return nullptr;
+}
+
+bool CycleHistory::rebuild()
+{
+    _index = {};
+    _index.magic = MAGIC;
+    _index.records[0] = fileRecords(HISTORY_CURRENT);
+    _index.records[1] = fileRecords(HISTORY_PREVIOUS);
+
+    // oldest first, so the totals' recency order comes out right
+    for (uint16_t back = count(); back-- > 0;)
+    {
+        CycleRecord record;
+        if (read(back, record))
+        {
+            _index.lastSeq = max(_index.lastSeq, record.seq);
+            account(record);
+        }
+    }
+    return saveIndex();
+}
+
+bool CycleHistory::saveIndex()
+{
+    _index.crc = rtcCrc32(&_index, offsetof(Index, crc));
+    File file = LittleFS.open(HISTORY_INDEX, "w");
+    if (!file)
+    {
+        return false;
+    }
+    const bool written = file.write(reinterpret_cast<const uint8_t *>(&_index), sizeof(_index)) == sizeof(_index);
+    file.close();
+    return written;
+}
+
+void CycleHistory::account(const CycleRecord &record)
+{
+    _index.lastSeq = max(_index.lastSeq, record.seq);
+    if (record.end == CYCLE_LOST)
+    {
+        return;
+    }
+
+    // this preset's slot, or the one run least recently
+    PresetStats *slot = &_index.preset[0];
+    for (PresetStats &stats : _index.preset)
+    {
+        if (stats.cycles && stats.preset == record.preset)
+        {
+            slot = &stats;
+            break;
+        }
+        if (stats.lastSeq < slot->lastSeq)
+        {
+            slot = &stats;
+        }
+    }
+    if (!slot->cycles || !(slot->preset == record.preset))
+    {
+        *slot = {};
+        slot->preset = record.preset;
+    }
+
+    slot->cycles++;
+    slot->lastSeq = record.seq;
+    if (record.toTempS != HISTORY_NEVER)
+    {
+        slot->toTempS += record.toTempS;
+        slot->reached++;
+    }
+    slot->overshootDF += record.overshootDF;
+    slot->energyDWh += record.energyDWh;
+}
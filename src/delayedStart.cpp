@@ -0,0 +1,32 @@
+/**
+ * @file delayedStart.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief "Ready in N minutes": heat late enough that the baths are ready on time
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "delayedStart.h"
+
+void DelayedStart::arm(uint32_t nowMs, uint32_t readyInS)
+{
+    _armedMs = nowMs;
+    _delayMs = readyInS * 1000;
+    _leadS = -1;
+}
+
+uint32_t DelayedStart::remainingS(uint32_t nowMs) const
+{
+    const uint32_t elapsed = nowMs - _armedMs;
+    return elapsed >= _delayMs ? 0 : (_delayMs - elapsed + 999) / 1000;
+}
+
+bool DelayedStart::due(uint32_t nowMs, long leadS)
+{
+    if (leadS < 0)
+    {
+        _leadS = -1;
+        return true;
+    }
+    _leadS = leadS + leadS * DELAY_MARGIN_PERCENT / 100 + DELAY_MARGIN_S;
+    return remainingS(nowMs) <= static_cast<uint32_t>(_leadS);
+}
@@ -0,0 +1,64 @@
+/**
+ * @file diagStats.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Loop rate and Ticker timing, for the diagnostics page
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "diagStats.h"
+
+#define DIAG_WINDOW_US 1000000
+
+static DiagStats s_stats = {};
+
+// the second being counted
+static uint32_t s_windowStart = 0;
+static uint16_t s_passes = 0;
+static uint32_t s_maxPassUs = 0;
+static uint32_t s_lastPass = 0;
+static uint16_t s_ticks = 0;
+static uint32_t s_tickJitterUs = 0;
+static uint32_t s_lastTick = 0;
+
+void diagLoopPass()
+{
+    uint32_t now = micros();
+    if (s_lastPass)
+    {
+        s_maxPassUs = max(s_maxPassUs, now - s_lastPass);
+    }
+    s_lastPass = now;
+    s_passes++;
+
+    if (now - s_windowStart >= DIAG_WINDOW_US)
+    {
+        s_stats.loopsPerSecond = s_passes;
+        s_stats.maxPassUs = s_maxPassUs;
+        s_stats.ticksPerSecond = s_ticks;
+        s_stats.tickJitterUs = s_tickJitterUs;
+        s_stats.maxTickJitterUs = max(s_stats.maxTickJitterUs, s_tickJitterUs);
+        s_windowStart = now;
+        s_passes = 0;
+        s_maxPassUs = 0;
+        s_ticks = 0;
+        s_tickJitterUs = 0;
+    }
+}
+
+void diagTick()
+{
+    uint32_t now = micros();
+    if (s_lastTick)
+    {
+        uint32_t period = now - s_lastTick;
+        uint32_t error = period > DIAG_TICK_US ? period - DIAG_TICK_US : DIAG_TICK_US - period;
+        s_tickJitterUs = max(s_tickJitterUs, error);
+    }
+    s_lastTick = now;
+    s_ticks++;
+}
+
+const DiagStats &diagStats()
+{
+    return s_stats;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file energy.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Heater and cleaner energy per cycle, and lifetime totals
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "energy.h"
+#include "resume.h"
+#include "postMortem.h"
+
+static constexpr uint32_t MAGIC = 0x4E524731; // 'NRG1'
+
+struct EnergyRecord
+{
+    uint32_t magic;
+    uint32_t reserved; // lifetime is 8 byte aligned
+    EnergyLifetime lifetime;
+    uint32_t crc;
+};
+static constexpr size_t CRC_BYTES = offsetof(EnergyRecord, crc);
+
+static_assert(sizeof(EnergyRecord) % 4 == 0, "RTC memory is written in 4 byte blocks");
+static_assert(ENERGY_RTC_BLOCK * 4 >= RESUME_RTC_BLOCK * 4 + sizeof(ResumeCheckpoint),
+              "energy totals overlap the resume checkpoint");
+static_assert(ENERGY_RTC_BLOCK * 4 + sizeof(EnergyRecord) <= POSTMORTEM_RTC_BLOCK * 4,
+              "energy totals overlap the post-mortem ring");
+
+void EnergyMeter::begin(const EnergyLifetime &saved)
+{
+    // erased EEPROM reads as all ones
+    _saved = saved.cycles == UINT32_MAX ? EnergyLifetime{} : saved;
+    _lifetime = _saved;
+
+    EnergyRecord record;
+    if (ESP.rtcUserMemoryRead(ENERGY_RTC_BLOCK, reinterpret_cast<uint32_t *>(&record), sizeof(record)) &&
+        record.magic == MAGIC && record.crc == rtcCrc32(&record, CRC_BYTES) &&
+        record.lifetime.cycles >= _saved.cycles && record.lifetime.heaterUs >= _saved.heaterUs)
+    {
+        // reset without losing power: these include cycles not yet in flash
+        _lifetime = record.lifetime;
+    }
+}
+
+void EnergyMeter::startCycle(uint8_t outputs, uint64_t heaterUs, uint64_t cleanerUs)
+{
+    _startMs = millis();
+    _cycle = {0, heaterUs, cleanerUs, outputs};
+}
+
+void EnergyMeter::endCycle(uint64_t heaterUs, uint64_t cleanerUs)
+{
+    _cycle.runMs = millis() - _startMs;
+    _cycle.heaterUs = heaterUs - _cycle.heaterUs;
+    _cycle.cleanerUs = cleanerUs - _cycle.cleanerUs;
+
+    _lifetime.cycles++;
+    _lifetime.runS += (_cycle.runMs + 500) / 1000;
+    _lifetime.heaterUs += _cycle.heaterUs;
+    _lifetime.cleanerUs += _cycle.cleanerUs;
+
+    EnergyRecord record = {MAGIC, 0, _lifetime, 0};
+    record.crc = rtcCrc32(&record, CRC_BYTES);
+    ESP.rtcUserMemoryWrite(ENERGY_RTC_BLOCK, reinterpret_cast<uint32_t *>(&record), sizeof(record));
+}
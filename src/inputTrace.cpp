@@ -0,0 +1,155 @@
+/**
+ * @file inputTrace.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Input trace recorder/replayer for input-to-display latency
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "inputTrace.h"
+
+#ifdef INPUT_TRACE
+
+static InputEvent s_events[INPUT_TRACE_MAX];
+static uint16_t s_head = 0; // next slot to write
+static uint16_t s_count = 0;
+static uint32_t s_dropped = 0;
+
+static uint8_t s_lastLevel = HIGH;
+static uint16_t s_lastHash = 0;
+static uint8_t s_lastScreen = 0xFF;
+
+static const InputEvent *s_replay = nullptr;
+static uint16_t s_replayCount = 0;
+static uint16_t s_replayNext = 0;
+static uint8_t s_replayLevel = HIGH;
+static int16_t s_replayPosition = 0;
+
+static void record(uint8_t kind, uint8_t screen, uint16_t value, uint32_t us)
+{
+    s_events[s_head] = {us, value, kind, screen};
+    s_head = (s_head + 1) % INPUT_TRACE_MAX;
+    if (s_count < INPUT_TRACE_MAX)
+    {
+        s_count++;
+    }
+    else
+    {
+        s_dropped++;
+    }
+}
+
+void inputTraceEncoder(int16_t position)
+{
+    record(INPUT_ENCODER, 0, static_cast<uint16_t>(position), micros());
+}
+
+void inputTraceButton(uint8_t level)
+{
+    if (level != s_lastLevel)
+    {
+        s_lastLevel = level;
+        record(INPUT_BUTTON, 0, level, micros());
+    }
+}
+
+void inputTraceFrame(uint8_t screen, uint32_t startUs, uint32_t endUs, uint16_t hash)
+{
+    // redrawing the same picture isn't a response to anything
+    if (hash == s_lastHash && screen == s_lastScreen)
+    {
+        return;
+    }
+    s_lastHash = hash;
+    s_lastScreen = screen;
+    uint32_t frameUs = endUs - startUs;
+    record(INPUT_FRAME, screen, frameUs > UINT16_MAX ? UINT16_MAX : frameUs, endUs);
+}
+
+uint16_t inputTraceCount()
+{
+    return s_count;
+}
+
+uint32_t inputTraceDropped()
+{
+    return s_dropped;
+}
+
+const InputEvent &inputTraceEvent(uint16_t index)
+{
+    return s_events[(s_head + INPUT_TRACE_MAX - s_count + index) % INPUT_TRACE_MAX];
+}
+
+void inputTraceClear()
+{
+    s_head = 0;
+    s_count = 0;
+    s_dropped = 0;
+}
+
+void inputTracePrint(Print &out, const char *const screenNames[], uint8_t screens)
+{
+    out.printf("TRACE begin events=%u dropped=%u replay=%u\n", s_count, s_dropped, s_replay != nullptr);
+    for (uint8_t i = 0; i < screens; i++)
+    {
+        out.printf("TRACE screen %u %s\n", i, screenNames[i]);
+    }
+    for (uint16_t i = 0; i < s_count; i++)
+    {
+        const InputEvent &e = inputTraceEvent(i);
+        out.printf("TRACE %u %c %u %u\n", e.us, e.kind, e.value, e.screen);
+    }
+    out.println("TRACE end");
+}
+
+void inputReplayBegin(const InputEvent *events, uint16_t count)
+{
+    s_replay = events;
+    s_replayCount = count;
+    s_replayNext = 0;
+}
+
+bool inputReplaying()
+{
+    return s_replay && s_replayNext < s_replayCount;
+}
+
+// Apply the next event if it's due.  One per call, so the button logic
+// sees every level even when the replay has fallen behind.
+static void replayAdvance()
+{
+    if (!inputReplaying())
+    {
+        return;
+    }
+    InputEvent e;
+    memcpy_P(&e, &s_replay[s_replayNext], sizeof(e));
+    if (static_cast<int32_t>(micros() - e.us) < 0)
+    {
+        return;
+    }
+    s_replayNext++;
+    if (e.kind == INPUT_BUTTON)
+    {
+        s_replayLevel = e.value;
+    }
+    else if (e.kind == INPUT_ENCODER)
+    {
+        s_replayPosition = static_cast<int16_t>(e.value);
+        inputTraceEncoder(s_replayPosition);
+    }
+}
+
+uint8_t inputReplayButton()
+{
+    replayAdvance();
+    return s_replayLevel;
+}
+
+int16_t inputReplayPosition()
+{
+    replayAdvance();
+    return s_replayPosition;
+}
+
+#endif // INPUT_TRACE
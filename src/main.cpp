@@ -127,9 +127,29 @@
 #include <DallasTemperature.h>
 #include <ESPRotary.h>
 #include <Button2.h>
-#include <U8g2lib.h>
 #include <EEPROM.h>
 #include "Ticker.h" // https://github.com/esp8266/Arduino/tree/master/libraries/Ticker
+#include "bathChannel.h"
+#include "scheduler.h"
+#include "resume.h"
+#include "cleanerMod.h"
+#include "energy.h"
+#include "cycleHistory.h"
+#include "delayedStart.h"
+#include "postMortem.h"
+#include "timerPresets.h"
+#include "timezones.h"
+#include "memStats.h"
+#include "diagStats.h"
+#include "display.h"
+#include "widgets.h"
+#include "uiChart.h"
+#include "bootTrace.h"
+#include "assetsTable.h" // generated from assets/images by scripts/asset_compiler.py
+#include "inputTrace.h"
+#ifdef INPUT_REPLAY
+#include "replayTrace.h" // generated from custom_replay_trace by scripts/trace_report.py
+#endif
 
 #ifdef WITH_GDB
 #include "GDBStub.h"
@@ -168,6 +188,21 @@
 // bool statusLedOn = false;
 
 #define CLICKS_PER_STEP 4
+
+// Baths run by this controller.  One bath drives the relays on D2/D1; more
+// than one puts every relay on the I2C expander (see outputs.h), up to 4.
+#ifndef BATH_CHANNELS
+#define BATH_CHANNELS 1
+#endif
+#if BATH_CHANNELS < 1 || BATH_CHANNELS > 4
+#error "BATH_CHANNELS must be 1..4"
+#endif
+#define CHANNEL_BUDGET_US 2000 // bath updates per loop pass (see scheduler.h)
+
+// Local time zone, by tz database name (see assets/zones.csv)
+#ifndef TIME_ZONE
+#define TIME_ZONE "America/New_York"
+#endif
 // -------------------------------------------------------------------------
 //  NOKIA 5110 LCD
 // #define sclk_pin D5
@@ -179,14 +214,35 @@
 // -------------------------------------------------------------------------
 // -------------------------------------------------------------------------
 
-U8G2_PCD8544_84X48_F_4W_SW_SPI u8g2(
-    U8G2_R0,        /* Rotation 0 = no rotation */
+// The panel driver is chosen at compile time with DISPLAY_BACKEND (see display.h)
+#if DISPLAY_BACKEND == DISPLAY_U8G2
+Display<DisplayBackend> display(
     LCD_SCLK_PIN,   /* clock */
     LCD_DIN_PIN,    /* data */
     LCD_CS_PIN,     /* cs */
     LCD_DC_PIN,     /* dc */
     LCD_RST_PIN     /* reset */
 );
+#elif DISPLAY_BACKEND == DISPLAY_PCD8544
+Display<DisplayBackend> display(
+    LCD_SCLK_PIN,   /* clock */
+    LCD_DIN_PIN,    /* data */
+    LCD_DC_PIN,     /* dc */
+    -1,             /* cs (tied low) */
+    -1              /* reset (RST switch) */
+);
+#elif DISPLAY_BACKEND == DISPLAY_LCD_I2C
+Display<DisplayBackend> display(
+    LCD_DIN_PIN,    /* SDA */
+    LCD_SCLK_PIN    /* SCL */
+);
+// there is one Wire bus, and display.begin() moves it to the panel's pins
+// after the channels have started the expander on its own
+static_assert(BATH_CHANNELS == 1 ||
+                  (OUTPUT_EXPANDER_SDA == LCD_DIN_PIN && OUTPUT_EXPANDER_SCL == LCD_SCLK_PIN),
+              "the I2C panel and the relay expander must share pins: "
+              "-D OUTPUT_EXPANDER_SDA=13 -D OUTPUT_EXPANDER_SCL=14");
+#endif
 
 // Temp Sensor Data Bus
 OneWire oneWire(ONE_WIRE_BUS);
@@ -198,59 +254,148 @@ DallasTemperature sensors(&oneWire);
 //                                  0x28, 0xFF, 0x57, 0x3F, 0x01, 0x16, 0x01, 0xED
 DeviceAddress thermometerAddress; // custom array type to hold 64 bit device address
 
+// The baths: sensor (by 1-Wire search order), heater, cleaner
+#if BATH_CHANNELS == 1
+BathChannel g_channels[] = {
+    BathChannel(sensors, 0, HEATER_PIN, MODULATED_PIN(CLEANER_PIN))}; // cleaner runs the pattern in cleanerMod.h
+#else
+BathChannel g_channels[] = {
+    BathChannel(sensors, 0, EXPANDER_PIN(0), EXPANDER_PIN(1)),
+    BathChannel(sensors, 1, EXPANDER_PIN(2), EXPANDER_PIN(3)),
+#if BATH_CHANNELS > 2
+    BathChannel(sensors, 2, EXPANDER_PIN(4), EXPANDER_PIN(5)),
+#endif
+#if BATH_CHANNELS > 3
+    BathChannel(sensors, 3, EXPANDER_PIN(6), EXPANDER_PIN(7)),
+#endif
+};
+#endif
+Scheduler g_scheduler(CHANNEL_BUDGET_US);
+
+// The running cycle, checkpointed to RTC memory once a second (see resume.h)
+static_assert(BATH_CHANNELS <= RESUME_MAX_CHANNELS, "resume checkpoint is too small");
+#define CHECKPOINT_MS 1000
+ResumeCheckpoint g_checkpoint;
+bool g_resumePending = false;
+
+// What each cycle costs, and the lifetime totals (see energy.h)
+EnergyMeter g_energy;
+
+// Every cycle's record, in LittleFS (see cycleHistory.h)
+CycleHistory g_history;
+CycleTracker g_cycleTracker;
+
+// "Ready in N minutes" (see delayedStart.h)
+DelayedStart g_delayedStart;
+
 // Rotary Encoder and button
 ESPRotary r;
 Ticker t;
 Button2 b;
 
 // Variables
-float currentTemperature = 0;
 uint8_t g_setTemperatureF;   // The set temperature in Fahrenheit
 uint8_t g_timerSetting;      // The timer to be set in minutes
+TimerPresets g_presets;      // (time, temperature) pairs, the one in use first
 uint8_t tempOffset = 10;     // Offset in Fahrenheit for heater control
 uint8_t g_contrast;          // The contrast for the display
 uint16_t longPress = 1000;   // one second long press of button
 int16_t last = 0;            // For rotary encoder reading
 
-volatile bool down  = false; // Flags for the encoder
-volatile bool up    = false;
+// EEPROM layout
+#define EE_SET_TEMP 0x00
+#define EE_TIMER 0x08
+#define EE_CONTRAST 0x10
+#define EE_CLEANER_MODE 0x18
+#define EE_THERMAL_MODEL 0x20 // ThermalModel::Params per channel, 24 bytes each
+#define EE_ENERGY 0x80        // EnergyLifetime, after four channels' models
+#define EE_PRESETS 0x98       // TimerPresets, 18 bytes
 
-// State variables
-volatile bool cleanerOn = false; // State of the cleaner
-volatile bool heaterOn = false;  // State of the heater
+// Menu structure (the items are in uiChart.h)
+uint8_t g_currentMenu = START_TIMER;
 
-// Menu structure
-enum MenuItems
+// The screens and the run, driven by input events (see uiChart.h)
+StateMachine<UiChart> g_ui(UI_CHART);
+
+// What the screens are showing or editing, set up as they're entered
+static unsigned long s_lastCheckpoint = 0;
+static CycleEnd s_cycleEnd = CYCLE_FINISHED;
+static bool s_resumed = false;           // the run uses the checkpoint's setpoint and timer,
+static uint8_t s_userSetTemperatureF = 0; // and these go back when it ends
+static uint8_t s_userTimerSetting = 0;
+static uint8_t s_presetSelected = 0;
+static Preset s_editPreset;
+static bool s_editAdding = false;
+static uint8_t s_editFields = 2;
+static uint8_t s_editCursor = 0;
+static uint8_t s_tempDigits[3];
+static uint8_t s_tempCursor = 0;
+static uint8_t s_cleanerMode = 0;
+static uint16_t s_readyInMin = 60;
+#define DIAGNOSTICS_LINES 6
+static uint8_t s_lastResetFirst = 0;
+static uint8_t s_diagnosticsFirst = 0;
+static Label s_contrastTitle(0, 0, 10, "Contrast: ");
+static NumberField s_contrastValue(10, 0, 3);
+static uint16_t s_historyBack = 0; // 0 the newest
+static CycleRecord s_historyRecord;
+static bool s_historyValid = false;
+
+// Start up work left for after the first frame (see finishBoot())
+enum BootStep
 {
-    START_TIMER,
-    SET_TIMER,
-    SET_TEMP,
-    NETWORK,
-    CONTRAST,
-    MENU_ITEMS_COUNT
+    BOOT_SENSOR,
+    BOOT_FIRST_READING,
+    BOOT_TIME_ZONE,
+    BOOT_HISTORY,
+    BOOT_DONE
 };
-uint8_t g_currentMenu = START_TIMER;
-
-// Function definitions
-void startTimerPage();
-void setTimerSubmenu();
-void setTemperatureSubmenu();
-void networkSettings();
-void adjustContrast();
-void displayMenu();
+#define BOOT_READING_TIMEOUT_MS 1000
+uint8_t g_bootStep = BOOT_SENSOR;
+unsigned long g_bootStepStart = 0;
+
+// Function definitions (the screens' are in uiChart.h)
+void checkpointCycle();
+uint64_t heaterOnMicros();
+uint64_t cleanerOnMicros();
+uint8_t presetRows();
+void editPresetStep(int8_t step);
+void usePreset(uint8_t index);
 void saveSettings();
 void loadSettings();
 void handleLoop();
-void readRotaryEncoder();
-void turnOnHeater();
-void turnOffHeater();
-void turnOnCleaner();
-void turnOffCleaner();
+void onTick();
+uint8_t readInput();
+void recordPostMortem();
 void turnOnBacklight();
 void turnOffBacklight();
+void sampleTemperature();
+void finishBoot();
+void printMinSec(long seconds);
+#ifdef INPUT_TRACE
+void traceFrame(uint32_t startUs, uint32_t endUs, uint16_t hash);
+void traceEncoder(ESPRotary &rotary);
+uint8_t readButton();
+void dumpInputTrace();
+#endif
+#ifdef DISPLAY_BENCH
+void displayBenchmark();
+#endif
+#ifdef ONEWIRE_BENCH
+void oneWireBenchmark();
+#endif
 
 void setup()
 {
+    // Relays off before anything else
+    ///////////////////////////////////////////////////////////////
+    for (BathChannel &channel : g_channels)
+    {
+        channel.begin();
+    }
+    backlightBegin(BACKLIGHT_PIN); // off
+    bootMark(F("pins"));
+
     debugbegin(115200);
     debug("Entered setup()...");
 
@@ -262,16 +407,38 @@ void setup()
 
     loadSettings(); // Load settings from EEPROM
 
-    // Initialize display
-    ///////////////////////////////////////////////////////////////
-    u8g2.begin();
-    u8g2.setContrast(g_contrast);
+    // a cycle that was cut short by a reset left a checkpoint behind
+    g_resumePending = resumeLoad(g_checkpoint) && g_checkpoint.channels == BATH_CHANNELS;
 
-    digitalWrite(BACKLIGHT_PIN, LOW); // turn off the backlight
+    // what led up to the reset, for the last_reset page
+    static const char *stateNames[ST_COUNT];
+    for (uint8_t i = 0; i < ST_COUNT; i++)
+    {
+        stateNames[i] = UI_CHART.states[i].name;
+    }
+    postMortemNames(stateNames, ST_COUNT, UI_CHART.eventNames, EV_COUNT);
+    postMortemBegin();
+#if DEBUG
+    postMortemPrint(Serial);
+#endif
+    bootMark(F("settings"));
 
-    // Initialize temperature sensor
+    // Initialize display
     ///////////////////////////////////////////////////////////////
-    sensors.begin();
+    display.begin();
+    display.setContrast(g_contrast);
+#ifdef INPUT_TRACE
+    display.onFrame(traceFrame);
+#endif
+    debug("Display buffer ");
+    debug(display.bufferBytes());
+    debugln(" bytes");
+    bootMark(F("display"));
+
+    // Put the splash up now; everything slow is finished by finishBoot()
+    // and the menu replaces it once that's done
+    g_ui.start(ST_SPLASH);
+    bootMark(F("first frame"));
 
     // Initialize rotary encoder
     ///////////////////////////////////////////////////////////////
@@ -289,26 +456,23 @@ void setup()
     // Initialize button
     ///////////////////////////////////////////////////////////////
     b.begin(ROTARY_BUTTON);
+#ifdef INPUT_TRACE
+    // read the button through the trace (and the replay, in place of the pin)
+    b.setButtonStateFunction(readButton);
+#ifdef INPUT_REPLAY
+    inputReplayBegin(REPLAY_TRACE, REPLAY_TRACE_COUNT);
+#else
+    r.setChangedHandler(traceEncoder);
+#endif
+#endif
     // set click handler callback used in the main menu
     // button.setClickHandler(buttonClicked);
     // button.setLongClickHandler(buttonLongPress);         // will only be called after the button has been released.
 
     // Initialize ticker
     ///////////////////////////////////////////////////////////////
-    t.attach_ms(10, handleLoop); // Call handleLoop every 10ms
-
-    // Initialize pins
-    ///////////////////////////////////////////////////////////////
-
-    pinMode(BACKLIGHT_PIN, OUTPUT);
-    pinMode(HEATER_PIN, OUTPUT);
-    pinMode(CLEANER_PIN, OUTPUT);
-    digitalWrite(HEATER_PIN, LOW);
-    digitalWrite(CLEANER_PIN, LOW);
-
-    // Read initial temperature
-    sensors.requestTemperatures();
-    currentTemperature = sensors.getTempFByIndex(0); // TODO: get address of sensor and use that instead
+    t.attach_ms(10, onTick); // poll the encoder and button every 10ms
+    bootMark(F("input"));
 
     // TODO: setup wifi
     // create a secret.h file as in nightdriver by Dave Plummer
@@ -319,489 +483,1758 @@ void setup()
     // TODO: setup rtc
     // incorporate easy NTP TZ DST.cpp
 
+#ifdef DISPLAY_BENCH
+    displayBenchmark();
+#endif
+#ifdef ONEWIRE_BENCH
+    oneWireBenchmark();
+#endif
+
     debugln("...setup Complete.");
 }
 
-void loop()
+/**
+ * @brief Finishes the slow parts of start up once the menu is live
+ *
+ * Called from sampleTemperature() every pass until it's done.  Each call does
+ * at most one step and none of them wait on the sensor:
+ *   - scan the 1-Wire bus (each channel's sampler starts a fast 9 bit conversion)
+ *   - wait for the first readings, giving up after BOOT_READING_TIMEOUT_MS
+ *   - look up the time zone rules
+ *   - mount LittleFS and load the cycle history's index
+ * Each step is marked in the boot trace, which debug builds print at the end.
+ */
+void finishBoot()
 {
-
-    debugln("Entering loop()...");
-
-    displayMenu();
-
-    // debug("displayMenu complete...");
-
-    readRotaryEncoder();
-
-    // debug("rotaryEncoder has been read...");
-
-    turnOnBacklight();
-
-    // handle encoder events on various menuItems
-    ////////////////////////////////////////////
-    if (down)
+    switch (g_bootStep)
     {
-        debug("down rotate...");
-
-        down = false;
-        g_currentMenu = (g_currentMenu + 1) % MENU_ITEMS_COUNT;
-    } // wrap around to first menu item when going down
-    
-    if (up)
+    case BOOT_SENSOR:
     {
-        debug("up rotate...");
-        up = false;
-        g_currentMenu = (g_currentMenu + MENU_ITEMS_COUNT - 1) % MENU_ITEMS_COUNT;
-    } // wrap around to last menu item when going up
-
-    // handle button events on various menuItems
-    ////////////////////////////////////////////
+        bool found = false;
+        postMortemProbe(PROBE_SENSOR_SCAN);
+        for (BathChannel &channel : g_channels)
+        {
+            found |= channel.beginSensor();
+        }
+        g_bootStep = found ? BOOT_FIRST_READING : BOOT_TIME_ZONE;
+        g_bootStepStart = millis();
+        bootMark(F("sensor scan"));
+        break;
+    }
 
-    if (b.wasPressed())
+    case BOOT_FIRST_READING:
     {
-        if (b.wasPressedFor() > longPress && g_currentMenu == START_TIMER)
+        bool waiting = false;
+        for (BathChannel &channel : g_channels)
         {
-
-            debug("b.waspressfor longpress on START_TIMER menuitem...");
-
-            startTimerPage();
+            waiting |= channel.sampler().present() && !channel.sampler().valid();
         }
-        else if (b.wasPressedFor() > longPress && g_currentMenu != START_TIMER)
+        if (!waiting || millis() - g_bootStepStart > BOOT_READING_TIMEOUT_MS)
         {
-            // do nothing
-            // No...wait. Do this - If backlight is off, turn it on.
-
-            debugln("b.wasPressedFor shortpress and NOT on START_TIMER menuitem");
-            if (digitalRead(BACKLIGHT_PIN) == LOW)
-            {
-                digitalWrite(BACKLIGHT_PIN, HIGH);
-            }
-            // and if backlight is on, turn it off.
-            else
-            {
-                digitalWrite(BACKLIGHT_PIN, LOW);
-            }
+            g_bootStep = BOOT_TIME_ZONE;
+            bootMark(F("first reading"));
         }
+        break;
+    }
 
-        // click press
-        // Switch on the selected menu item
+    case BOOT_TIME_ZONE:
+    {
+        // Local time rules (DST included) from the flash zone table
+        char tzRuleBuffer[TZ_RULE_MAX];
+        if (tzLookup(TIME_ZONE, tzRuleBuffer, sizeof(tzRuleBuffer)))
+        {
+            setTZ(tzRuleBuffer);
+        }
+        else
+        {
+            debugln("Unknown TIME_ZONE " TIME_ZONE);
+        }
+        g_bootStep = BOOT_HISTORY;
+        bootMark(F("time zone"));
+        break;
+    }
 
-        switch (g_currentMenu)
+    case BOOT_HISTORY:
+    {
+        if (!g_history.begin())
         {
-        case START_TIMER:
-            // wasn't a long press so do nothing
-            break;
-        case SET_TIMER:
-            setTimerSubmenu();
-            break;
-        case SET_TEMP:
-            setTemperatureSubmenu();
-            break;
-        case NETWORK:
-            networkSettings();
-            break;
-        case CONTRAST:
-            adjustContrast();
-            break;
-        default:
-            // do nothing (how did we get here?)
-            break;
+            debugln("No cycle history (LittleFS)");
         }
-        debugln("Loop complete.");
+        g_bootStep = BOOT_DONE;
+        bootMark(F("history"));
+#if DEBUG
+        bootTracePrint(Serial);
+#endif
+        break;
+    }
+
+    case BOOT_DONE:
+    default:
+        break;
     }
 }
 
 /**
- * @brief Shows the timer page
+ * @brief One pass: keep everything running, then feed the state chart
  *
- * This function is called when the user selects the "Start Timer"
- * menu item. It will display the timer counting down and
- * control the heater and ultrasonic cleaner. The user can
- * exit the timer page by pressing the button.
+ * Input becomes events for the chart (uiChart.h), and the current state's
+ * run action draws its screen.  Nothing here waits, so the baths, the
+ * resume checkpoint and the diagnostics keep going whatever is on show.
  */
-void startTimerPage()
+void loop()
 {
-    unsigned long startTime = millis();
-    while (true)
+    handleLoop();
+    sampleTemperature();
+    memStatsSample();
+
+#ifdef INPUT_REPLAY
+    // dump the replayed session once the last inputs have had time to show
+    static unsigned long replayDone = 0;
+    static bool replayDumped = false;
+    if (!replayDumped && !inputReplaying())
     {
-        handleLoop();
-        unsigned long currentTime = millis();
-        int32_t remainingTime = static_cast<int32_t>(g_timerSetting) * 60 -
-                                static_cast<int32_t>((currentTime - startTime) / 1000);
-
-        if (remainingTime <= 0)
-        {
-            turnOffCleaner();
-            turnOffHeater();
-            break;
-        }
-
-        sensors.requestTemperatures();
-        currentTemperature = sensors.getTempFByIndex(0);
-
-        if (currentTemperature < (g_setTemperatureF - tempOffset))
-        {
-            turnOnHeater();
-            turnOffCleaner();
-        }
-        else
+        if (replayDone == 0)
         {
-            turnOffHeater();
-            turnOnCleaner();
+            replayDone = millis();
         }
-
-        u8g2.clearBuffer();
-        u8g2.setFont(u8g2_font_6x10_tf);
-        u8g2.setCursor(0, 10);
-        u8g2.print("Time Left: ");
-        u8g2.print(remainingTime / 60);
-        u8g2.print(":");
-        if ((remainingTime % 60) < 10)
+        else if (millis() - replayDone > 2000)
         {
-            u8g2.print("0");
+            replayDumped = true;
+            dumpInputTrace();
         }
-        u8g2.print(remainingTime % 60);
-        u8g2.setCursor(0, 30);
-        u8g2.print("Temp: ");
-        u8g2.print(currentTemperature);
-        u8g2.print("F / ");
-        u8g2.print(g_setTemperatureF);
-        u8g2.print("F");
-        u8g2.sendBuffer();
+    }
+#endif
 
-        if (b.wasPressedFor() > longPress)
-        {
-            break;
-        }
+    const uint8_t event = readInput();
+    if (event != NO_EVENT)
+    {
+        postMortemRecord(PM_INPUT, event);
+        g_ui.dispatch(event);
     }
-    turnOffCleaner();
-    turnOffHeater();
+    g_ui.run();
+    recordPostMortem();
 }
 
 /**
- * @brief Shows the timer selection submenu
+ * @brief Puts the screen changes and relay edges in the post-mortem ring
  *
- * The user can cycle through the available preset times (5, 10, 15, 20, 25, 30 minutes)
- * by rotating the encoder. The selected time is displayed on the screen.
- * The user can confirm the selection by pressing the encoder button, which will
- * save the new setting and exit the menu.
+ * Polled once a pass.  A state entered and left within one pass is missed,
+ * but a relay can't be: each holds a state for its minimum dwell, seconds
+ * rather than passes.
  */
-void setTimerSubmenu()
+void recordPostMortem()
 {
-    static const uint8_t presets[] = {3, 8, 10, 15, 20, 30, 60};
-    const uint8_t presetsCount = sizeof(presets) / sizeof(presets[0]);
-    uint8_t selectedIndex = 0;
-    for (uint8_t i = 0; i < presetsCount; i++)
+    static uint8_t state = NO_STATE;
+    static uint8_t heaters = 0;
+    static uint8_t cleaners = 0;
+    if (g_ui.state() != state)
     {
-        if (presets[i] == g_timerSetting)
-        {
-            selectedIndex = i;
-            break;
-        }
+        state = g_ui.state();
+        postMortemRecord(PM_STATE, state);
     }
-    while (true)
+    for (uint8_t i = 0; i < BATH_CHANNELS; i++)
     {
-        handleLoop();
-        readRotaryEncoder();
-        u8g2.clearBuffer();
-        u8g2.setFont(u8g2_font_6x10_tf);
-        u8g2.setCursor(0, 10);
-        u8g2.print("Set Timer: ");
-        u8g2.print(presets[selectedIndex]);
-        u8g2.print(" min");
-        u8g2.sendBuffer();
-
-        if (down)
+        const uint8_t bit = 1 << i;
+        if (g_channels[i].heater().isOn() != static_cast<bool>(heaters & bit))
         {
-            down = false;
-            selectedIndex = (selectedIndex + 1) % presetsCount;
+            heaters ^= bit;
+            postMortemRecord(PM_HEATER, i | (heaters & bit ? POSTMORTEM_ON : 0));
         }
-        else if (up)
+        if (g_channels[i].cleaner().isOn() != static_cast<bool>(cleaners & bit))
         {
-            up = false;
-            selectedIndex = (selectedIndex + presetsCount - 1) % presetsCount;
+            cleaners ^= bit;
+            postMortemRecord(PM_CLEANER, i | (cleaners & bit ? POSTMORTEM_ON : 0));
         }
+    }
+}
 
-        if (b.wasPressed())
-        {
-            g_timerSetting = presets[selectedIndex];
-            saveSettings();
-            break;
-        }
+// ===============================================================
+// The screens, as the states of uiChart.h
+// ---------------------------------------------------------------
+
+/// The splash, with the backlight on, until finishBoot() is done
+void splashEnter()
+{
+    display.frame([&]
+    {
+        display.image(asset_splash);
+    });
+    turnOnBacklight();
+}
+
+void splashRun()
+{
+    if (g_bootStep == BOOT_DONE)
+    {
+        g_ui.post(EV_BOOTED);
     }
 }
 
+bool resumePending(uint8_t)
+{
+    return g_resumePending;
+}
+
 /**
- * @brief Shows the temperature selection submenu
+ * The main menu (displayMenu() draws it): the encoder moves the selection,
+ * wrapping around at either end.  A click opens the selected page; a long
+ * press on "Start Timer" starts a run, and on any other item switches the
+ * backlight.  A double click shows the diagnostics, a triple click the
+ * memory budget.
+ */
+bool menuAt(uint8_t item)
+{
+    return g_currentMenu == item;
+}
+
+void menuNext()
+{
+    g_currentMenu = (g_currentMenu + 1) % MENU_ITEMS_COUNT;
+}
+
+void menuPrevious()
+{
+    g_currentMenu = (g_currentMenu + MENU_ITEMS_COUNT - 1) % MENU_ITEMS_COUNT;
+}
+
+/// Leaving any settings page for the menu
+void settingsExit()
+{
+    saveSettings();
+}
+
+/**
+ * @brief Starts every bath on the set temperature and timer
  *
- * The user can cycle through the three digits of the temperature by rotating the encoder.
- * The selected digit is highlighted on the screen.
- * The user can confirm the selection by pressing the encoder button, which will
- * save the new setting and exit the menu.
- * Holding the encoder button down for more than 1 second will also save and exit.
- */
-void setTemperatureSubmenu()
-{
-    uint8_t cursorPosition = 0;
-    /*
-     * This line of code is initializing an array  of 3 unsigned 8-bit
-     * integers (uint8_t digits[3]) with the individual digits of the
-     * temperature value stored in g_setTemperatureF.
-     *
-     * Here's a breakdown of how it's done:
-     *
-     * g_setTemperatureF % 10 gets the last digit (ones place)of the
-     * temperature value.
-     * (g_setTemperatureF / 10) % 10 gets the middle digit (tens place)
-     * of the temperature value. The division by 10 shifts the digits
-     * one place to the right, and then the modulo 10 operation gets
-     * the last digit of the result, which is the original tens place.
-     * g_setTemperatureF / 100 gets the first digit (hundreds place)
-     * of the temperature value. The division by 100 shifts the digits
-     * two places to the right.
-     * For example, if g_setTemperatureF is 123, the array digits would
-     * be initialized with the values {3, 2, 1}.
-     *
-     */
-
-    uint8_t digits[3] = {
-        static_cast<uint8_t>(g_setTemperatureF / 100),
-        static_cast<uint8_t>((g_setTemperatureF / 10) % 10),
-        static_cast<uint8_t>(g_setTemperatureF % 10)};
-
-    while (true)
+ * The long press on "Start Timer"; entering the cycle state does the rest.
+ */
+void cycleStart()
+{
+    for (BathChannel &channel : g_channels)
     {
-        handleLoop();
-        readRotaryEncoder();
-        u8g2.clearBuffer();
-        u8g2.setFont(u8g2_font_6x10_tf);
-        u8g2.setCursor(0, 10);
-        u8g2.print("Set Temp: ");
-        for (uint8_t i = 0; i < 3; i++)
+        channel.start(static_cast<uint32_t>(g_timerSetting) * 60);
+    }
+}
+
+/// A run, new or resumed, begins: its statistics, energy and first checkpoint
+void cycleEnter()
+{
+    g_scheduler.resetStats();
+    g_energy.startCycle(BATH_CHANNELS, heaterOnMicros(), cleanerOnMicros());
+    g_cycleTracker.start({g_timerSetting, g_setTemperatureF}, BATH_CHANNELS);
+    s_cycleEnd = CYCLE_FINISHED;
+    s_lastCheckpoint = millis();
+    checkpointCycle();
+}
+
+/**
+ * @brief Shows the timer page for the cycle that's running
+ *
+ * Shows the baths counting down while the channels run their heaters and
+ * ultrasonic cleaners, and checkpoints the cycle once a second so a reset
+ * can resume it.  A long press ends the run early; it also ends when every
+ * bath has finished.
+ */
+void timerRun()
+{
+    if (millis() - s_lastCheckpoint >= CHECKPOINT_MS)
+    {
+        s_lastCheckpoint += CHECKPOINT_MS;
+        checkpointCycle();
+    }
+
+    bool running = false;
+    for (uint8_t i = 0; i < BATH_CHANNELS; i++)
+    {
+        BathChannel &channel = g_channels[i];
+        running |= channel.running();
+        if (channel.sampler().valid())
         {
-            if (i == cursorPosition)
-            {
-                u8g2.setDrawColor(1);
-                u8g2.drawBox((i + 1) * 10, 10, 10, 10);
-                u8g2.setDrawColor(0);
-            }
-            u8g2.print(digits[i]);
+            g_cycleTracker.sample(i, channel.temperatureF(), channel.readyTemperatureF());
         }
-        u8g2.print("F");
-        u8g2.sendBuffer();
+    }
+    if (!running)
+    {
+        g_ui.post(EV_CYCLE_DONE);
+        return;
+    }
 
-        if (down)
+#if BATH_CHANNELS == 1
+    const BathChannel &bath = g_channels[0];
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print("Left  ");
+        printMinSec(bath.remainingSeconds());
+        display.setCursor(0, 1);
+        display.print("Temp  ");
+        display.print(bath.temperatureF(), 1);
+        display.print("F");
+        display.setCursor(0, 2);
+        display.print("Set   ");
+        display.print(g_setTemperatureF);
+        display.print("F");
+        if (bath.temperatureF() < bath.readyTemperatureF())
         {
-            down = false;
-            digits[cursorPosition] = (digits[cursorPosition] + 1) % 10;
+            display.setCursor(0, 3);
+            display.print("Ready ");
+            if (bath.etaSeconds() < 0)
+            {
+                display.print("--:--");
+            }
+            else
+            {
+                printMinSec(bath.etaSeconds());
+            }
         }
-        else if (up)
+    });
+#else
+    // one line per bath, "2 128.4F heat", under the time left if there's room
+    const uint8_t firstRow = BATH_CHANNELS < display.ROWS ? 1 : 0;
+    display.frame([&]
+    {
+        if (firstRow)
         {
-            up = false;
-            digits[cursorPosition] = (digits[cursorPosition] - 1 + 10) % 10;
+            display.setCursor(0, 0);
+            display.print("Left  ");
+            printMinSec(g_channels[0].remainingSeconds());
         }
-
-        // move the cursor position
-        if (b.wasPressed())
+        for (uint8_t i = 0; i < BATH_CHANNELS && firstRow + i < display.ROWS; i++)
         {
-            cursorPosition = (cursorPosition + 1) % 3;
+            display.setCursor(0, firstRow + i);
+            display.print(i + 1);
+            display.print(" ");
+            display.print(g_channels[i].temperatureF(), 1);
+            display.print("F ");
+            display.print(g_channels[i].status());
         }
+    });
+#endif
+}
 
-        // long press will save and exit
-        if (b.wasPressedFor() > longPress)
-        {
-            g_setTemperatureF = digits[0] * 100 + digits[1] * 10 + digits[2];
-            saveSettings();
-            break;
-        }
-    }
+/// How the run ends, for its history record
+void cycleFinished()
+{
+    s_cycleEnd = CYCLE_FINISHED;
+}
+
+void cycleStopped()
+{
+    s_cycleEnd = CYCLE_STOPPED;
 }
 
 /**
- * @brief Implementation for network settings
+ * @brief A run ends, finished or stopped
  *
- * This function is called when the network menu option is selected.
- * It should handle the network settings.
- *
- * @todo Implement network settings
+ * Stops the baths, closes the cycle's energy account, adds its history
+ * record and keeps what the thermal models learned.  The energy summary
+ * follows.
  */
-void networkSettings()
+void cycleExit()
 {
-    // Implementation for network settings
-    while (true)
+    resumeClear();
+    bool learned = false;
+    for (BathChannel &channel : g_channels)
     {
-        handleLoop();
-        if (b.wasPressed())
-        {
-            saveSettings();
-            break;
-        }
+        channel.stop();
+    }
+    g_energy.endCycle(heaterOnMicros(), cleanerOnMicros());
+    CycleRecord record = g_cycleTracker.finish(s_cycleEnd, g_energy.lastCycle());
+    g_history.add(record);
+    if (s_resumed)
+    {
+        g_setTemperatureF = s_userSetTemperatureF;
+        g_timerSetting = s_userTimerSetting;
+        s_resumed = false;
+    }
+    for (BathChannel &channel : g_channels)
+    {
+        learned |= channel.model().dirty();
+        debug("Relay switches: heater ");
+        debug(channel.heater().switches());
+        debug(", cleaner ");
+        debugln(channel.cleaner().switches());
+    }
+    debug("Bath updates: worst wait ");
+    debug(g_scheduler.maxWaitUs());
+    debug(" us, over budget ");
+    debugln(g_scheduler.overruns());
+    debug("Checkpoint ");
+    debug(resumeSaveMicros());
+    debugln(" us");
+#if DEBUG
+    CleanerJitter jitter = cleanerModJitter();
+    debug("Cleaner edges ");
+    debug(jitter.edges);
+    debug(", late ");
+    debug(jitter.minLateUs);
+    debug("..");
+    debug(jitter.maxLateUs);
+    debugln(" us");
+#endif
+
+    // keep what the models learned during this run; the energy totals go
+    // along, or on their own once enough is at stake
+    if (learned || g_energy.saveDue())
+    {
+        saveSettings();
     }
 }
 
 /**
- * @brief Adjusts the display contrast
+ * @brief Shows what the cycle that just ended cost
  *
- * Allows the user to cycle through contrast settings with the rotary encoder.
- * The selected contrast is highlighted on the display.
- * When the user presses the button, the current contrast is saved and the menu exits.
+ * Run time, heater and cleaner duty and energy, then the lifetime totals,
+ * as far down as the panel has rows.  Any press, or ENERGY_SUMMARY_MS,
+ * goes back to the menu.
  */
-void adjustContrast()
+void energyRun()
 {
-    while (true)
+    const EnergyUse &cycle = g_energy.lastCycle();
+    const EnergyLifetime &lifetime = g_energy.lifetime();
+    display.frame([&]
     {
-        handleLoop();
-        readRotaryEncoder();
-        u8g2.clearBuffer();
-        u8g2.setFont(u8g2_font_6x10_tf);
-        u8g2.setCursor(0, 10);
-        u8g2.print("Contrast: ");
-        u8g2.print(g_contrast);
-        u8g2.sendBuffer();
-
-        if (up)
-        {
-            up = false;
-            g_contrast = min(g_contrast + 1, 255);
-        }
-        else if (down)
-        {
-            down = false;
-            g_contrast = max(g_contrast - 1, 0);
-        }
-        u8g2.setContrast(g_contrast);
-
-        // long press will save and exit
-        if (b.wasPressedFor() > longPress)
-        {
-            saveSettings();
-            break;
-        }
-    }
+        display.setCursor(0, 0);
+        display.print("Run   ");
+        printMinSec(cycle.runMs / 1000);
+        display.setCursor(0, 1);
+        display.print("Heat ");
+        display.print(cycle.heaterDuty());
+        display.print("% ");
+        display.print(cycle.heaterWh(), cycle.heaterWh() < 10 ? 1 : 0);
+        display.print("Wh");
+        display.setCursor(0, 2);
+        display.print("Clean ");
+        display.print(cycle.cleanerDuty());
+        display.print("% ");
+        display.print(cycle.cleanerWh(), cycle.cleanerWh() < 10 ? 1 : 0);
+        display.print("Wh");
+        display.setCursor(0, 3);
+        display.print("Life ");
+        display.print(lifetime.wh() / 1000.0f, 1);
+        display.print("kWh");
+        display.setCursor(0, 4);
+        display.print("Runs ");
+        display.print(static_cast<unsigned long>(lifetime.cycles));
+    });
 }
 
 /**
- * @brief Displays the main menu
+ * @brief Shows past cycles, newest first
  *
- * Clears the display, sets the font to u8g2_font_6x10_tf, and draws the menu items
- * on the display. The currently selected item is highlighted with a white box.
+ * One cycle a screen: its number and preset, the time it took to get to
+ * temperature, the overshoot, the energy and how it ended, then that
+ * preset's averages from the index.  The encoder steps to older and newer
+ * cycles; any press goes back to the menu.
  */
-void displayMenu()
+void historyEnter()
+{
+    s_historyBack = 0;
+    s_historyValid = g_history.read(s_historyBack, s_historyRecord);
+}
+
+void historyOlder()
+{
+    if (s_historyBack + 1 < g_history.count())
+    {
+        s_historyBack++;
+        s_historyValid = g_history.read(s_historyBack, s_historyRecord);
+    }
+}
+
+void historyNewer()
+{
+    if (s_historyBack)
+    {
+        s_historyBack--;
+        s_historyValid = g_history.read(s_historyBack, s_historyRecord);
+    }
+}
+
+void historyRun()
 {
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x10_tf);
-    for (uint8_t i = 0; i < MENU_ITEMS_COUNT; i++)
+    static const char *const ends[] = {"done", "stop", "lost"};
+    const CycleRecord &r = s_historyRecord;
+    const PresetStats *average = s_historyValid ? g_history.stats(r.preset) : nullptr;
+    display.frame([&]
     {
-        u8g2.setCursor(0, (i + 1) * 10);
-        if (i == g_currentMenu)
+        display.setCursor(0, 0);
+        if (!s_historyValid)
+        {
+            display.print(g_history.ready() ? "No history" : "No filesystem");
+            return;
+        }
+        display.print("#");
+        display.print(r.seq);
+        display.print(" ");
+        display.print(r.preset.minutes);
+        display.print("m ");
+        display.print(r.preset.temperatureF);
+        display.print("F");
+        display.setCursor(0, 1);
+        display.print("Heat ");
+        if (r.toTempS == HISTORY_NEVER)
         {
-            u8g2.setDrawColor(1);
-            u8g2.drawBox(0, i * 10, 84, 10);
-            u8g2.setDrawColor(0);
+            display.print("--:--");
         }
         else
         {
-            u8g2.setDrawColor(1);
+            printMinSec(r.toTempS);
         }
-        switch (i)
+        display.setCursor(0, 2);
+        display.print("Over ");
+        display.print(r.overshootDF / 10.0f, 1);
+        display.print("F");
+        display.setCursor(0, 3);
+        display.print(r.energyDWh / 10.0f, 1);
+        display.print("Wh ");
+        display.print(r.end < sizeof(ends) / sizeof(ends[0]) ? ends[r.end] : "?");
+        if (average)
         {
-        case START_TIMER:
-            u8g2.print("Start Timer");
-            break;
-        case SET_TIMER:
-            u8g2.print("Set Timer");
-            break;
-        case SET_TEMP:
-            u8g2.print("Set Temp");
-            break;
-        case NETWORK:
-            u8g2.print("Network");
-            break;
-        case CONTRAST:
-            u8g2.print("Contrast");
-            break;
+            display.setCursor(0, 4);
+            display.print("Avg ");
+            if (average->averageToTempS() == HISTORY_NEVER)
+            {
+                display.print("--:--");
+            }
+            else
+            {
+                printMinSec(average->averageToTempS());
+            }
+            display.print(" ");
+            display.print(average->averageOvershootF(), 1);
+            display.print("F");
         }
-    }
-    u8g2.sendBuffer();
+    });
 }
 
-/**
- * @brief Handles the loop tasks for the rotary encoder and button.
- *
- * Call this method repeatedly to handle the rotary encoder and button events.
- */
-void handleLoop()
+/// Every bath's heater on time, added up
+uint64_t heaterOnMicros()
 {
-    r.loop();
-    b.loop();
+    uint64_t us = 0;
+    for (const BathChannel &channel : g_channels)
+    {
+        us += channel.heaterOnMicros();
+    }
+    return us;
 }
 
-void readRotaryEncoder()
+/// Every bath's cleaner on time, added up
+uint64_t cleanerOnMicros()
 {
-    int16_t position = r.getPosition();
-
-    if (position > last)
+    uint64_t us = 0;
+    for (const BathChannel &channel : g_channels)
     {
-        last = position;
-        down = true;
-    }
-    else if (position < last)
-    {
-        last = position;
-        up = true;
+        us += channel.cleanerOnMicros();
     }
+    return us;
 }
 
-// =================================================================
-// =================================================================
-// Device control functions
-// -----------------------------
 /**
- * @brief Turns on the heater
+ * @brief Writes the running cycle to RTC memory (see resume.h)
  *
- * This function will turn on the heater by setting the HEATER_PIN
- * high and setting the heaterOn flag to true.
+ * A few microseconds and no flash: safe to do every second.
  */
-void turnOnHeater()
+void checkpointCycle()
 {
-    // Turn on the heater
-    digitalWrite(HEATER_PIN, HIGH);
-    heaterOn = true;
+    g_checkpoint.setTemperatureF = g_setTemperatureF;
+    g_checkpoint.timerMinutes = g_timerSetting;
+    g_checkpoint.channels = BATH_CHANNELS;
+    for (uint8_t i = 0; i < BATH_CHANNELS; i++)
+    {
+        const BathChannel &channel = g_channels[i];
+        g_checkpoint.channel[i] = {channel.remainingMs(), channel.phase(),
+                                   channel.heater().isOn(), channel.cleaner().isOn(), 0};
+    }
+    resumeSave(g_checkpoint);
 }
+
 /**
- * @brief Turns off the heater
+ * @brief Offers to carry on a cycle a reset interrupted
  *
- * This function will turn off the heater by setting the HEATER_PIN
- * low and setting the heaterOn flag to false.
+ * Shown once the boot has finished, when RTC memory held a valid checkpoint.
+ * A click resumes it with the time that was left and the set temperature
+ * it was started with; a long press, or RESUME_OFFER_MS without an answer,
+ * drops it.  It never restarts the heater on its own.  The relays come
+ * back through the channels' normal control, dwell times and all.
  */
-void turnOffHeater()
+void resumeRun()
 {
-    // Turn off the heater
-    digitalWrite(HEATER_PIN, LOW);
-    heaterOn = false;
+    const ResumeChannel &first = g_checkpoint.channel[0];
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print("Resume run?");
+        display.setCursor(0, 1);
+        display.print("Left  ");
+        printMinSec((first.remainingMs + 999) / 1000);
+        display.setCursor(0, 2);
+        display.print("Click: yes");
+        display.setCursor(0, 3);
+        display.print("Hold:  no");
+        display.setCursor(0, 4); // off the bottom of a 4 line panel
+        display.print("Set   ");
+        display.print(g_checkpoint.setTemperatureF);
+        display.print("F");
+    });
 }
 
-void turnOnCleaner()
+void resumeAccept()
 {
-    digitalWrite(CLEANER_PIN, HIGH);
-    cleanerOn = true;
+    // the cycle's own settings, for this run only: cycleExit() puts the
+    // user's back before anything is saved
+    s_resumed = true;
+    s_userSetTemperatureF = g_setTemperatureF;
+    s_userTimerSetting = g_timerSetting;
+    g_setTemperatureF = g_checkpoint.setTemperatureF;
+    g_timerSetting = g_checkpoint.timerMinutes;
+    for (uint8_t i = 0; i < BATH_CHANNELS; i++)
+    {
+        if (g_checkpoint.channel[i].remainingMs)
+        {
+            g_channels[i].resume(g_checkpoint.channel[i].remainingMs);
+        }
+    }
 }
 
-void turnOffCleaner()
+/// The interrupted cycle goes in the history as lost
+void resumeDecline()
 {
-    digitalWrite(CLEANER_PIN, LOW);
-    cleanerOn = false;
+    const uint32_t remainingS = (g_checkpoint.channel[0].remainingMs + 999) / 1000;
+    CycleRecord record = {};
+    record.runS = g_checkpoint.timerMinutes * 60UL - min<uint32_t>(remainingS, g_checkpoint.timerMinutes * 60UL);
+    record.toTempS = HISTORY_NEVER;
+    record.preset = {g_checkpoint.timerMinutes, g_checkpoint.setTemperatureF};
+    record.end = CYCLE_LOST;
+    g_history.add(record);
+    resumeClear();
 }
 
+/**
+ * @brief Sets how long until the baths are wanted, for a delayed start
+ *
+ * The encoder moves it DELAY_STEP_MIN at a time, up to DELAY_MAX_MIN.  A
+ * click arms it with the preset in use; a long press goes back to the
+ * menu without.
+ */
+void readyInRun()
+{
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print("Ready in");
+        display.setCursor(0, 1);
+        display.print(s_readyInMin / 60);
+        display.print("h ");
+        if (s_readyInMin % 60 < 10)
+        {
+            display.print("0");
+        }
+        display.print(s_readyInMin % 60);
+        display.print("m");
+        display.setCursor(0, 2);
+        display.print("Run ");
+        display.print(g_timerSetting);
+        display.print("m ");
+        display.print(g_setTemperatureF);
+        display.print("F");
+        display.setCursor(0, 3);
+        display.print("Click: arm");
+    });
+}
+
+void readyInIncrement()
+{
+    s_readyInMin = min<uint16_t>(s_readyInMin + DELAY_STEP_MIN, DELAY_MAX_MIN);
+}
+
+void readyInDecrement()
+{
+    s_readyInMin = max<uint16_t>(s_readyInMin - DELAY_STEP_MIN, DELAY_STEP_MIN);
+}
+
+void delayedArm()
+{
+    g_delayedStart.arm(millis(), s_readyInMin * 60UL);
+}
+
+/**
+ * @brief The longest heat-up any bath needs, for the delayed start
+ *
+ * From each bath's thermal model; where the model can't say, the average
+ * this preset has taken to get to temperature before.  -1 when neither
+ * knows, or a bath has no reading.
+ */
+static long delayedLeadS()
+{
+    long leadS = 0;
+    for (BathChannel &channel : g_channels)
+    {
+        if (!channel.sampler().valid())
+        {
+            return -1;
+        }
+        long etaS = channel.model().etaSeconds(channel.temperatureF(), channel.readyTemperatureF(), false);
+        if (etaS < 0)
+        {
+            const PresetStats *stats = g_history.stats({g_timerSetting, g_setTemperatureF});
+            if (!stats || stats->averageToTempS() == HISTORY_NEVER)
+            {
+                return -1;
+            }
+            etaS = stats->averageToTempS();
+        }
+        leadS = max(leadS, etaS);
+    }
+    return leadS;
+}
+
+/**
+ * @brief Waits, heaters off, until a delayed start has to heat
+ *
+ * Shows how long until the baths are wanted and until the heaters go on.
+ * When they must, the run starts (delayedHeat()) with the wait still left
+ * added to its timer, so the countdown reaches the preset's time about as
+ * the baths get to temperature.  A long press cancels.
+ */
+void delayedRun()
+{
+    const uint32_t now = millis();
+    if (g_delayedStart.due(now, delayedLeadS()))
+    {
+        g_ui.post(EV_HEAT);
+        return;
+    }
+
+    const uint32_t remainingS = g_delayedStart.remainingS(now);
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print("Ready ");
+        printMinSec(remainingS);
+        display.setCursor(0, 1);
+        display.print("Heat  ");
+        printMinSec(static_cast<long>(remainingS) - g_delayedStart.leadS());
+        display.setCursor(0, 2);
+        display.print("Temp  ");
+        display.print(g_channels[0].temperatureF(), 1);
+        display.print("F");
+        display.setCursor(0, 3);
+        display.print("Hold: cancel");
+    });
+}
+
+void delayedHeat()
+{
+    const uint32_t runS = g_delayedStart.remainingS(millis()) + g_timerSetting * 60UL;
+    for (BathChannel &channel : g_channels)
+    {
+        channel.start(runS);
+    }
+}
+
+/**
+ * @brief Prints a duration as m:ss at the current cursor
+ *
+ * @param seconds the duration to print
+ */
+void printMinSec(long seconds)
+{
+    display.print(seconds / 60);
+    display.print(":");
+    if ((seconds % 60) < 10)
+    {
+        display.print("0");
+    }
+    display.print(seconds % 60);
+}
+
+/**
+ * @brief Shows the timer presets
+ *
+ * The (time, temperature) presets, most recently used first, so the list
+ * opens on the one in use.  Turning the encoder moves the selection; a
+ * click runs with the selected preset from now on (it moves to the top),
+ * a long press edits it.  The last row adds a new preset while there's
+ * room for one.
+ */
+void setTimerEnter()
+{
+    s_presetSelected = 0;
+}
+
+void setTimerRun()
+{
+    const uint8_t rows = presetRows();
+    const uint8_t first = s_presetSelected >= display.ROWS ? s_presetSelected - display.ROWS + 1 : 0;
+    display.frame([&]
+    {
+        for (uint8_t row = 0; row < display.ROWS && first + row < rows; row++)
+        {
+            const uint8_t i = first + row;
+            char label[16];
+            if (i < g_presets.count)
+            {
+                snprintf(label, sizeof(label), "%3um %3uF", g_presets[i].minutes, g_presets[i].temperatureF);
+            }
+            else
+            {
+                strcpy(label, "New preset");
+            }
+            display.menuItem(row, label, i == s_presetSelected);
+        }
+    });
+}
+
+/// The presets, and "New preset" while there's room for one
+uint8_t presetRows()
+{
+    return g_presets.count + (g_presets.full() ? 0 : 1);
+}
+
+void setTimerNext()
+{
+    s_presetSelected = (s_presetSelected + 1) % presetRows();
+}
+
+void setTimerPrevious()
+{
+    s_presetSelected = (s_presetSelected + presetRows() - 1) % presetRows();
+}
+
+bool presetIsNew(uint8_t)
+{
+    return s_presetSelected == g_presets.count;
+}
+
+void setTimerUse()
+{
+    usePreset(s_presetSelected);
+}
+
+/**
+ * @brief Edits one timer preset, or makes a new one
+ *
+ * The one selected in the list, or a new one on "New preset".  The encoder
+ * changes the field under the cursor (time, temperature and, for an
+ * existing preset, delete); a click moves the cursor.  A long press saves
+ * - or deletes, with the cursor on "Delete" - and goes back to the list.
+ * The preset saved becomes the one in use.
+ */
+void editPresetEnter()
+{
+    s_editAdding = s_presetSelected >= g_presets.count;
+    s_editPreset = s_editAdding ? Preset{g_timerSetting, g_setTemperatureF} : g_presets[s_presetSelected];
+    s_editFields = s_editAdding || g_presets.count == 1 ? 2 : 3;
+    s_editCursor = 0;
+}
+
+void editPresetRun()
+{
+    const Preset &p = s_editPreset;
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print(s_editAdding ? "New preset" : "Edit preset");
+        display.setCursor(0, 1);
+        display.print("Time ");
+        display.setInverse(s_editCursor == 0);
+        display.print(p.minutes);
+        display.setInverse(false);
+        display.print(" min");
+        display.setCursor(0, 2);
+        display.print("Temp ");
+        display.setInverse(s_editCursor == 1);
+        display.print(p.temperatureF);
+        display.setInverse(false);
+        display.print("F");
+        if (s_editFields > 2)
+        {
+            display.setCursor(0, 3);
+            display.setInverse(s_editCursor == 2);
+            display.print("Delete");
+            display.setInverse(false);
+        }
+    });
+}
+
+/// Step the field under the cursor by one
+void editPresetStep(int8_t step)
+{
+    if (s_editCursor == 0)
+    {
+        s_editPreset.minutes = constrain(s_editPreset.minutes + step, 1, 255);
+    }
+    else if (s_editCursor == 1)
+    {
+        s_editPreset.temperatureF = constrain(s_editPreset.temperatureF + step, 1, 255);
+    }
+}
+
+void editPresetIncrement()
+{
+    editPresetStep(1);
+}
+
+void editPresetDecrement()
+{
+    editPresetStep(-1);
+}
+
+void editPresetNextField()
+{
+    s_editCursor = (s_editCursor + 1) % s_editFields;
+}
+
+void editPresetSave()
+{
+    if (s_editCursor == 2)
+    {
+        g_presets.remove(s_presetSelected);
+        usePreset(0);
+    }
+    else if (s_editAdding)
+    {
+        g_presets.add(s_editPreset);
+        usePreset(0);
+    }
+    else
+    {
+        usePreset(g_presets.edit(s_presetSelected, s_editPreset));
+    }
+    saveSettings();
+    s_presetSelected = 0; // an edited or new preset goes to the top
+}
+
+/**
+ * @brief Makes preset `index` the one in use
+ *
+ * It moves to the top of the list, and the timer and set temperature
+ * follow it.
+ */
+void usePreset(uint8_t index)
+{
+    g_presets.use(index);
+    g_timerSetting = g_presets[0].minutes;
+    g_setTemperatureF = g_presets[0].temperatureF;
+}
+
+/**
+ * @brief Shows the temperature selection submenu
+ *
+ * The user can cycle through the three digits of the temperature by rotating the encoder.
+ * The selected digit is highlighted on the screen, and a click moves to the next one.
+ * Holding the encoder button down for more than 1 second saves and exits.
+ */
+void setTempEnter()
+{
+    // the hundreds, tens and ones: 123 is {1, 2, 3}
+    s_tempDigits[0] = g_setTemperatureF / 100;
+    s_tempDigits[1] = (g_setTemperatureF / 10) % 10;
+    s_tempDigits[2] = g_setTemperatureF % 10;
+    s_tempCursor = 0;
+}
+
+void setTempRun()
+{
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print("Set Temp: ");
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            display.setInverse(i == s_tempCursor);
+            display.print(s_tempDigits[i]);
+        }
+        display.setInverse(false);
+        display.print("F");
+    });
+}
+
+void setTempIncrement()
+{
+    s_tempDigits[s_tempCursor] = (s_tempDigits[s_tempCursor] + 1) % 10;
+}
+
+void setTempDecrement()
+{
+    s_tempDigits[s_tempCursor] = (s_tempDigits[s_tempCursor] - 1 + 10) % 10;
+}
+
+void setTempNextDigit()
+{
+    s_tempCursor = (s_tempCursor + 1) % 3;
+}
+
+void setTempSave()
+{
+    g_setTemperatureF = s_tempDigits[0] * 100 + s_tempDigits[1] * 10 + s_tempDigits[2];
+    if (g_setTemperatureF)
+    {
+        // the preset in use follows
+        usePreset(g_presets.edit(0, {g_timerSetting, g_setTemperatureF}));
+    }
+}
+
+/**
+ * @brief Shows the memory budget
+ *
+ * Free heap (and the lowest it has been), the largest free block,
+ * fragmentation and how much of the loop stack has never been touched.
+ * Hidden behind a triple click on the main menu; any press exits.
+ */
+void memoryEnter()
+{
+#if DEBUG
+    memStatsPrint(Serial);
+#endif
+#ifdef INPUT_TRACE
+    dumpInputTrace();
+#endif
+}
+
+void memoryRun()
+{
+    const MemStats &m = memStats();
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print("Heap ");
+        display.print(m.freeHeap);
+        display.setCursor(0, 1);
+        display.print(" min ");
+        display.print(m.minFreeHeap);
+        display.setCursor(0, 2);
+        display.print("Blk ");
+        display.print(m.maxFreeBlock);
+        display.print(" ");
+        display.print(m.fragmentation);
+        display.print("%");
+        display.setCursor(0, 3);
+        display.print("Stack ");
+        display.print(m.minFreeStack);
+    });
+}
+
+/**
+ * @brief Shows how the firmware is keeping up, live
+ *
+ * Loop passes per second (and the longest pass), the 10ms Ticker's jitter
+ * (this second, and worst since boot), the slowest sensor conversion, the
+ * last display flush, free heap and relay switches since boot.  The
+ * encoder scrolls on panels too short for all of it.  Hidden behind a
+ * double click on the main menu; any press exits.
+ */
+void diagnosticsEnter()
+{
+    s_diagnosticsFirst = 0;
+}
+
+void diagnosticsScrollDown()
+{
+    s_diagnosticsFirst = min<uint8_t>(s_diagnosticsFirst + 1,
+                                      DIAGNOSTICS_LINES > display.ROWS ? DIAGNOSTICS_LINES - display.ROWS : 0);
+}
+
+void diagnosticsScrollUp()
+{
+    s_diagnosticsFirst = s_diagnosticsFirst ? s_diagnosticsFirst - 1 : 0;
+}
+
+void diagnosticsRun()
+{
+    const DiagStats &diag = diagStats();
+    uint16_t conversionMs = 0;
+    unsigned long heaterSwitches = 0;
+    unsigned long cleanerSwitches = 0;
+    for (BathChannel &channel : g_channels)
+    {
+        conversionMs = max(conversionMs, channel.sampler().conversionMs());
+        heaterSwitches += channel.heater().switches();
+        cleanerSwitches += channel.cleaner().switches();
+    }
+    const uint8_t first = s_diagnosticsFirst;
+    display.frame([&]
+    {
+        for (uint8_t row = 0; row < display.ROWS && first + row < DIAGNOSTICS_LINES; row++)
+        {
+            display.setCursor(0, row);
+            switch (first + row)
+            {
+            case 0:
+                display.print("Loop ");
+                display.print(diag.loopsPerSecond);
+                display.print("/s ");
+                display.print(diag.maxPassUs / 1000);
+                display.print("ms");
+                break;
+            case 1:
+                display.print("Tick ");
+                display.print(diag.tickJitterUs);
+                display.print("/");
+                display.print(diag.maxTickJitterUs);
+                display.print("us");
+                break;
+            case 2:
+                display.print("Conv ");
+                display.print(conversionMs);
+                display.print("ms");
+                break;
+            case 3:
+                display.print("Flush ");
+                display.print(display.flushMicros());
+                display.print("us");
+                break;
+            case 4:
+                display.print("Heap ");
+                display.print(memStats().freeHeap);
+                break;
+            case 5:
+                display.print("Relay H");
+                display.print(heaterSwitches);
+                display.print(" C");
+                display.print(cleanerSwitches);
+                break;
+            }
+        }
+    });
+}
+
+/**
+ * @brief Shows what led up to the last reset (see postMortem.h)
+ *
+ * The reset reason, with the program counter after a watchdog or an
+ * exception, then the events found in RTC memory at boot, newest first.
+ * Each is timed back from the last event before its reset, in seconds.
+ * The encoder scrolls.  Opened by a click on the diagnostics, and
+ * straight after the boot when the reset was a crash.
+ */
+bool resetCrashed(uint8_t)
+{
+    return postMortemCrashed();
+}
+
+void lastResetEnter()
+{
+    s_lastResetFirst = 0;
+}
+
+void lastResetScrollDown()
+{
+    const uint8_t lines = 2 + postMortemCount();
+    s_lastResetFirst = min<uint8_t>(s_lastResetFirst + 1, lines > display.ROWS ? lines - display.ROWS : 0);
+}
+
+void lastResetScrollUp()
+{
+    s_lastResetFirst = s_lastResetFirst ? s_lastResetFirst - 1 : 0;
+}
+
+void lastResetRun()
+{
+    const uint8_t first = s_lastResetFirst;
+    const uint8_t count = postMortemCount();
+    display.frame([&]
+    {
+        // the run an event belongs to ends at the newest event before a boot marker
+        uint32_t endMs = count ? postMortemEvent(count - 1).ms : 0;
+        for (uint8_t line = 0, row = 0; line < 2 + count && row < display.ROWS; line++)
+        {
+            char text[24];
+            if (line == 0)
+            {
+                snprintf(text, sizeof(text), "%s", postMortemReason());
+            }
+            else if (line == 1)
+            {
+                if (postMortemCrashed())
+                {
+                    snprintf(text, sizeof(text), "pc %08x", postMortemReset().epc1);
+                }
+                else
+                {
+                    snprintf(text, sizeof(text), "%u events", count);
+                }
+            }
+            else
+            {
+                const PostMortemEvent &event = postMortemEvent(count - 1 - (line - 2));
+                const uint32_t agoMs = endMs - event.ms;
+                const int used = snprintf(text, sizeof(text), "-%u.%u ", agoMs / 1000, agoMs % 1000 / 100);
+                postMortemDescribe(event, text + used, sizeof(text) - used);
+                if (event.kind == PM_BOOT && line - 2 + 1 < count)
+                {
+                    endMs = postMortemEvent(count - 1 - (line - 2 + 1)).ms;
+                }
+            }
+            if (line >= first)
+            {
+                text[min<size_t>(display.COLS, sizeof(text) - 1)] = '\0';
+                display.setCursor(0, row++);
+                display.print(text);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Adjusts the display contrast
+ *
+ * Allows the user to cycle through contrast settings with the rotary encoder,
+ * seeing each one as it's chosen.  A long press saves it and exits.  Only
+ * the number is redrawn when it changes.
+ */
+void contrastEnter()
+{
+    display.invalidate();
+}
+
+void contrastRun()
+{
+    s_contrastValue.set(g_contrast);
+    display.compose(s_contrastTitle, s_contrastValue);
+}
+
+void contrastUp()
+{
+    g_contrast = min(g_contrast + 1, 255);
+    display.setContrast(g_contrast);
+}
+
+void contrastDown()
+{
+    g_contrast = max(g_contrast - 1, 0);
+    display.setContrast(g_contrast);
+}
+
+/**
+ * @brief Chooses how the ultrasonic cleaner runs
+ *
+ * The rotary encoder steps through the modes in cleanerMod.h; the page also
+ * shows how much the last run's pulse edges wandered.  A long press saves
+ * the mode and exits.
+ */
+void cleanerModeEnter()
+{
+    s_cleanerMode = cleanerModSelected();
+}
+
+void cleanerModeRun()
+{
+    const CleanerJitter jitter = cleanerModJitter();
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print("Cleaner:");
+        display.setCursor(0, 1);
+        display.print(cleanerMode(s_cleanerMode).name);
+        if (jitter.edges)
+        {
+            display.setCursor(0, 2);
+            display.print("Jitter ");
+            display.print(jitter.jitterUs());
+            display.print("us");
+        }
+    });
+}
+
+void cleanerModeNext()
+{
+    s_cleanerMode = (s_cleanerMode + 1) % cleanerModeCount();
+}
+
+void cleanerModePrevious()
+{
+    s_cleanerMode = (s_cleanerMode + cleanerModeCount() - 1) % cleanerModeCount();
+}
+
+void cleanerModeSave()
+{
+    cleanerModSelect(s_cleanerMode);
+}
+
+/**
+ * @brief Displays the main menu
+ *
+ * Draws the menu items, one per row, with the selected one in reverse video.
+ * On panels with fewer rows than items the list scrolls to keep the
+ * selection in view.  The first item shows the preset a long press on it
+ * will run.  The rows are retained: moving the selection redraws the two
+ * rows it moved between, and a pass where nothing changed draws nothing.
+ */
+void displayMenu()
+{
+    static const char *const labels[MENU_ITEMS_COUNT] = {
+        "Start Timer", "Ready In", "Presets", "Set Temp", "Network", "Contrast", "Cleaner Mode", "History"};
+    char start[16];
+    snprintf(start, sizeof(start), "Run %um %uF", g_timerSetting, g_setTemperatureF);
+
+    uint8_t first = 0;
+    if (g_currentMenu >= display.ROWS)
+    {
+        first = g_currentMenu - display.ROWS + 1;
+    }
+
+    static MenuItem rows[display.ROWS];
+    static bool placed = false;
+    if (!placed)
+    {
+        for (uint8_t row = 0; row < display.ROWS; row++)
+        {
+            rows[row].place(0, row, display.COLS);
+        }
+        placed = true;
+    }
+
+    for (uint8_t row = 0; row < display.ROWS; row++)
+    {
+        const uint8_t item = first + row;
+        if (item < MENU_ITEMS_COUNT)
+        {
+            rows[row].set(item == START_TIMER ? start : labels[item], item == g_currentMenu);
+        }
+        else
+        {
+            rows[row].set("", false);
+        }
+    }
+    display.compose(rows);
+}
+
+#ifdef DISPLAY_BENCH
+/**
+ * @brief The panel's bus traffic on one screen, in transfers a second
+ *
+ * Sending the contrast every pass, as the screens used to, against the
+ * cached settings going out with the frame only when they changed.  With
+ * `stepContrast` the encoder moves a step every CONTRAST_STEP_PASSES passes.
+ */
+static void busBenchmark(const char *screen, void (*run)(), bool stepContrast)
+{
+    const uint16_t passes = 200;
+    const uint8_t CONTRAST_STEP_PASSES = 20;
+    const uint8_t contrast = g_contrast;
+    uint32_t tps[2];
+
+    for (uint8_t coalesced = 0; coalesced < 2; coalesced++)
+    {
+        display.invalidate();
+        run(); // settle: the screen's first frame is all new either way
+        const uint32_t transfers = display.transactions();
+        const uint32_t start = micros();
+        for (uint16_t i = 0; i < passes; i++)
+        {
+            if (stepContrast && i % CONTRAST_STEP_PASSES == 0)
+            {
+                g_contrast = contrast + (i / CONTRAST_STEP_PASSES) % 2; // back and forth a step
+                display.setContrast(g_contrast);
+            }
+            if (!coalesced)
+            {
+                display.backend().control({g_contrast, display.bias()});
+            }
+            run();
+            yield();
+        }
+        const uint32_t elapsed = max<uint32_t>(micros() - start, 1);
+        tps[coalesced] = static_cast<uint64_t>(display.transactions() - transfers) * 1000000 / elapsed;
+    }
+    g_contrast = contrast;
+    display.setContrast(g_contrast);
+
+    Serial.printf("DISPLAY_BENCH_BUS backend=%d screen=%s passes=%u every_pass_tps=%u coalesced_tps=%u\n",
+                  DISPLAY_BACKEND, screen, passes, tps[0], tps[1]);
+}
+
+/**
+ * @brief Times main menu frames on the backend this build was made for
+ *
+ * Built into the bench_* environments only.  Draws the menu with the
+ * selection moving every frame (so a diffing backend has work to do), then
+ * shows the average and worst frame time and prints a line for
+ * scripts/display_bench.py to pick up, then the bus traffic on the idle
+ * menu and the contrast screen.  Any press carries on to the menu.
+ */
+void displayBenchmark()
+{
+    const uint16_t frames = 200;
+    uint32_t frameTotal = 0;
+    uint32_t flushTotal = 0;
+    uint32_t worst = 0;
+
+    for (uint16_t i = 0; i < frames; i++)
+    {
+        g_currentMenu = i % MENU_ITEMS_COUNT;
+        displayMenu();
+        frameTotal += display.frameMicros();
+        flushTotal += display.flushMicros();
+        worst = max(worst, display.frameMicros());
+        yield();
+    }
+    g_currentMenu = START_TIMER;
+
+    Serial.begin(115200);
+    Serial.printf("DISPLAY_BENCH backend=%d buffer=%u pages=%u frames=%u frame_us=%u flush_us=%u worst_us=%u\n",
+                  DISPLAY_BACKEND, display.bufferBytes(), display.pages(), frames,
+                  frameTotal / frames, flushTotal / frames, worst);
+    busBenchmark("menu", displayMenu, false);
+    busBenchmark("contrast", contrastRun, true);
+
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print("Frame ");
+        display.print(frameTotal / frames);
+        display.print("us");
+        display.setCursor(0, 1);
+        display.print("Flush ");
+        display.print(flushTotal / frames);
+        display.print("us");
+        display.setCursor(0, 2);
+        display.print("Worst ");
+        display.print(worst);
+        display.print("us");
+        display.setCursor(0, 3);
+        display.print("Buf ");
+        display.print(display.bufferBytes());
+        display.print("B/");
+        display.print(display.pages());
+        display.print("pg");
+    });
+
+    while (!b.wasPressed())
+    {
+        handleLoop();
+        yield();
+    }
+    b.read();
+}
+#endif // DISPLAY_BENCH
+
+#ifdef ONEWIRE_BENCH
+// Interrupts-off time, seen from outside the driver, so the in-tree driver
+// and the stock library are measured alike: timer1 ticks every PROBE_US,
+// and a tick that runs late fell due while interrupts were off.  Each late
+// tick stands for PROBE_US of that time, and the latest is (at least) the
+// longest window.  Nothing else has timer1 while the benchmark runs.
+#define PROBE_US 10
+
+static uint32_t s_probePeriod = 0; // CPU cycles
+static uint32_t s_probeSlack = 0;  // lateness that's only entry jitter
+static volatile uint32_t s_probeDue = 0;
+static volatile uint32_t s_probeLateTicks = 0;
+static volatile uint32_t s_probeMaxLate = 0;
+static volatile bool s_probeSynced = false;
+
+static void IRAM_ATTR probeTick()
+{
+    const uint32_t now = ESP.getCycleCount();
+    if (!s_probeSynced)
+    {
+        s_probeDue = now + s_probePeriod;
+        s_probeSynced = true;
+        return;
+    }
+    const int32_t late = static_cast<int32_t>(now - s_probeDue);
+    if (late > static_cast<int32_t>(s_probeSlack))
+    {
+        // ticks that fell due meanwhile were merged into this one
+        const uint32_t missed = late / s_probePeriod;
+        s_probeLateTicks += 1 + missed;
+        if (static_cast<uint32_t>(late) > s_probeMaxLate)
+        {
+            s_probeMaxLate = late;
+        }
+        s_probeDue += missed * s_probePeriod;
+    }
+    s_probeDue += s_probePeriod;
+}
+
+static void probeStart()
+{
+    s_probeLateTicks = 0;
+    s_probeMaxLate = 0;
+    s_probeSynced = false;
+    timer1_attachInterrupt(probeTick);
+    timer1_enable(TIM_DIV1, TIM_EDGE, TIM_LOOP);
+    timer1_write(80 * PROBE_US); // timer1 counts at 80MHz
+}
+
+static void probeStop()
+{
+    timer1_disable();
+    timer1_detachInterrupt();
+}
+
+/**
+ * @brief Interrupts-off time on the 1-Wire bus, this driver or the stock one
+ *
+ * Built into env:bench_onewire and env:bench_onewire_stock.  Times one
+ * conversion request and one scratchpad readout of the first sensor,
+ * through DallasTemperature as the firmware does, several times over, with
+ * the timer1 probe above; an idle run first finds the probe's own jitter.
+ * The in-tree driver's build also prints what the driver counts itself
+ * (include/OneWire.h), as a check on the probe.  Prints a line per
+ * operation and shows them; any press carries on to the menu.
+ */
+void oneWireBenchmark()
+{
+#ifdef ONEWIRE_STOCK
+    const char *const driver = "stock";
+#else
+    const char *const driver = "gpio16";
+#endif
+    const uint8_t runs = 10;
+    struct Result
+    {
+        uint32_t lateTicks = 0;
+        uint32_t maxLateCycles = 0;
+        uint32_t selfCycles = 0; // the driver's own count, in-tree only
+    } convert, readout;
+
+    const uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+    s_probePeriod = PROBE_US * cyclesPerUs;
+    s_probeSlack = 0;
+    probeStart();
+    delayMicroseconds(20000); // busy, interrupts on
+    probeStop();
+    s_probeSlack = s_probeMaxLate + cyclesPerUs;
+
+    auto measure = [&](Result &result, auto operation)
+    {
+#ifndef ONEWIRE_STOCK
+        OneWire::resetStats();
+#endif
+        probeStart();
+        operation();
+        probeStop();
+        result.lateTicks += s_probeLateTicks;
+        result.maxLateCycles = max<uint32_t>(result.maxLateCycles, static_cast<uint32_t>(s_probeMaxLate));
+#ifndef ONEWIRE_STOCK
+        result.selfCycles += OneWire::stats().irqOffCycles;
+#endif
+    };
+
+    DeviceAddress address;
+    sensors.begin();
+    const bool found = sensors.getAddress(address, 0);
+    sensors.setWaitForConversion(false);
+    for (uint8_t i = 0; found && i < runs; i++)
+    {
+        measure(convert, [&] { sensors.requestTemperaturesByAddress(address); });
+        delay(sensors.millisToWaitForConversion(12));
+        measure(readout, [&] { sensors.getTempF(address); });
+    }
+
+    Serial.begin(115200, SERIAL_8N1, SERIAL_TX_ONLY);
+    if (!found)
+    {
+        Serial.println("ONEWIRE_BENCH no sensor");
+    }
+    for (const Result *result : {&convert, &readout})
+    {
+        Serial.printf("ONEWIRE_BENCH driver=%s op=%s runs=%u irqoff_us=%u max_window_us=%u probe_us=%u",
+                      driver, result == &convert ? "convert" : "readout", runs,
+                      result->lateTicks * PROBE_US / runs, result->maxLateCycles / cyclesPerUs, PROBE_US);
+#ifndef ONEWIRE_STOCK
+        Serial.printf(" self_irqoff_us=%u", result->selfCycles / cyclesPerUs / runs);
+#endif
+        Serial.println();
+    }
+    Serial.flush();
+    Serial.end();
+    pinMode(LCD_DC_PIN, OUTPUT);
+
+    display.frame([&]
+    {
+        display.setCursor(0, 0);
+        display.print(driver);
+        display.print(" irq off");
+        display.setCursor(0, 1);
+        display.print("Conv ");
+        display.print(convert.lateTicks * PROBE_US / runs);
+        display.print("us");
+        display.setCursor(0, 2);
+        display.print("Read ");
+        display.print(readout.lateTicks * PROBE_US / runs);
+        display.print("us");
+        display.setCursor(0, 3);
+        display.print("Window ");
+        display.print(max(convert.maxLateCycles, readout.maxLateCycles) / cyclesPerUs);
+        display.print("us");
+    });
+
+    while (!b.wasPressed())
+    {
+        handleLoop();
+        yield();
+    }
+    b.read();
+}
+#endif // ONEWIRE_BENCH
+
+/**
+ * @brief Handles the loop tasks for the rotary encoder and button.
+ *
+ * Call this method repeatedly to handle the rotary encoder and button events.
+ */
+void handleLoop()
+{
+    diagLoopPass();
+    r.loop();
+    b.loop();
+}
+
+/**
+ * @brief The 10ms Ticker callback
+ *
+ * handleLoop()'s input polling, timed for the diagnostics page but not
+ * counted as a loop pass.
+ */
+void onTick()
+{
+    diagTick();
+    r.loop();
+    b.loop();
+}
+
+/**
+ * @brief Keeps the baths running
+ *
+ * Finishes the boot, then gives the channels their share of this pass
+ * (see Scheduler).  A channel's update never blocks: it collects a finished
+ * conversion, starts the next one, teaches its thermal model and, during a
+ * run, decides its relays.  The point the heater switches at is what the
+ * resolution policy aims for.
+ */
+void sampleTemperature()
+{
+    if (g_bootStep != BOOT_DONE)
+    {
+        finishBoot();
+    }
+    for (BathChannel &channel : g_channels)
+    {
+        channel.setReadyTemperature(g_setTemperatureF - tempOffset);
+    }
+    g_scheduler.run(g_channels, BATH_CHANNELS);
+}
+
+/**
+ * @brief The next input, as an event for the state chart
+ *
+ * Encoder steps first, then the button: a release after longPress is a
+ * hold, and Button2's click count tells double and triple clicks apart.
+ * Reading the press uses it up, so a page never sees the one that
+ * opened it.
+ */
+uint8_t readInput()
+{
+#ifdef INPUT_REPLAY
+    int16_t position = inputReplayPosition();
+#else
+    int16_t position = r.getPosition();
+#endif
+
+    if (position > last)
+    {
+        last = position;
+        return EV_DOWN;
+    }
+    if (position < last)
+    {
+        last = position;
+        return EV_UP;
+    }
+
+    if (b.wasPressed())
+    {
+        const uint8_t clicks = b.getNumberOfClicks();
+        const bool hold = b.wasPressedFor() > longPress;
+        b.read();
+        if (clicks == 3)
+        {
+            return EV_TRIPLE;
+        }
+        if (clicks == 2)
+        {
+            return EV_DOUBLE;
+        }
+        return hold ? EV_HOLD : EV_CLICK;
+    }
+    return NO_EVENT;
+}
+
+#ifdef INPUT_TRACE
+// -----------------------------------------------------------------
+// Input trace hooks (see inputTrace.h)
+
+void traceFrame(uint32_t startUs, uint32_t endUs, uint16_t hash)
+{
+    inputTraceFrame(g_ui.state(), startUs, endUs, hash);
+}
+
+void traceEncoder(ESPRotary &rotary)
+{
+    inputTraceEncoder(rotary.getPosition());
+}
+
+uint8_t readButton()
+{
+#ifdef INPUT_REPLAY
+    uint8_t level = inputReplayButton();
+#else
+    uint8_t level = digitalRead(ROTARY_BUTTON);
+#endif
+    inputTraceButton(level);
+    return level;
+}
+
+/**
+ * @brief Writes the input trace out for scripts/trace_report.py
+ *
+ * TX doubles as the panel's D/C line, so outside debug builds the UART is
+ * borrowed (transmit only, RX is the button) and the pin handed back after.
+ */
+void dumpInputTrace()
+{
+    // the screens are the chart's states
+    const char *names[ST_COUNT];
+    for (uint8_t i = 0; i < ST_COUNT; i++)
+    {
+        names[i] = UI_CHART.states[i].name;
+    }
+#if !DEBUG
+    Serial.begin(115200, SERIAL_8N1, SERIAL_TX_ONLY);
+#endif
+    inputTracePrint(Serial, names, ST_COUNT);
+    Serial.flush();
+#if !DEBUG
+    Serial.end();
+    pinMode(LCD_DC_PIN, OUTPUT);
+#endif
+}
+#endif // INPUT_TRACE
+
 // ===============================================================
 // ===============================================================
 // EEPROM functions
 // ----------------
 void saveSettings()
 {
-    EEPROM.put(0x0, g_setTemperatureF);
-    EEPROM.put(0x8, g_timerSetting);
-    EEPROM.put(0x10, g_contrast);
+    EEPROM.put(EE_SET_TEMP, g_setTemperatureF);
+    EEPROM.put(EE_TIMER, g_timerSetting);
+    EEPROM.put(EE_CONTRAST, g_contrast);
+    EEPROM.put(EE_CLEANER_MODE, cleanerModSelected());
+    EEPROM.put(EE_ENERGY, g_energy.lifetime());
+    EEPROM.put(EE_PRESETS, g_presets);
+    g_energy.saved();
+    for (uint8_t i = 0; i < BATH_CHANNELS; i++)
+    {
+        EEPROM.put(EE_THERMAL_MODEL + i * sizeof(ThermalModel::Params), g_channels[i].model().params());
+        g_channels[i].model().clearDirty();
+    }
+    postMortemProbe(PROBE_EEPROM_COMMIT);
     EEPROM.commit();
 }
 /// @brief Load settings from EEPROM.  Apply defaults if not found
@@ -810,9 +2243,22 @@ void loadSettings()
 
     debug("\tEntered loadSettings()...");
 
-    EEPROM.get(0, g_setTemperatureF);
-    EEPROM.get(8, g_timerSetting);
-    EEPROM.get(10, g_contrast);
+    EEPROM.get(EE_SET_TEMP, g_setTemperatureF);
+    EEPROM.get(EE_TIMER, g_timerSetting);
+    EEPROM.get(EE_CONTRAST, g_contrast);
+    uint8_t cleanerModeIndex;
+    EEPROM.get(EE_CLEANER_MODE, cleanerModeIndex);
+    cleanerModSelect(cleanerModeIndex); // unknown (erased) falls back to continuous
+    EnergyLifetime energy;
+    EEPROM.get(EE_ENERGY, energy);
+    g_energy.begin(energy);
+
+    for (uint8_t i = 0; i < BATH_CHANNELS; i++)
+    {
+        ThermalModel::Params model;
+        EEPROM.get(EE_THERMAL_MODEL + i * sizeof(ThermalModel::Params), model);
+        g_channels[i].model().load(model); // ignored if nothing has been learned yet
+    }
 
     if (g_setTemperatureF == 0)
     {
@@ -826,19 +2272,32 @@ void loadSettings()
     {
         g_contrast = 64;
     }
-    // u8g2.setContrast(g_contrast); // this is done in setup after calling loadSettings()
+
+    // one read for the whole list; the first time, it starts from the old settings
+    EEPROM.get(EE_PRESETS, g_presets);
+    if (!g_presets.valid())
+    {
+        g_presets.reset({g_timerSetting, g_setTemperatureF});
+    }
+    usePreset(0);
+    // display.setContrast(g_contrast); // this is done in setup after calling loadSettings()
 
     debug("\texiting loadSettings()");
 }
 
 void turnOffBacklight()
 {
-    digitalWrite(BACKLIGHT_PIN, LOW);
+    display.setBacklight(0, BACKLIGHT_FADE_MS);
     debugln("Backlight off");
 }
 
 void turnOnBacklight()
 {
-    digitalWrite(BACKLIGHT_PIN, HIGH);
+    display.setBacklight(BACKLIGHT_ON, BACKLIGHT_FADE_MS);
     debugln("Backlight on");
 }
+
+void toggleBacklight()
+{
+    display.setBacklight(display.backlight() ? 0 : BACKLIGHT_ON, BACKLIGHT_FADE_MS);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file memStats.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Runtime heap and stack high-water tracking
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "memStats.h"
+
+#define MEM_STATS_INTERVAL_MS 1000
+
+static MemStats s_stats = {0, UINT32_MAX, 0, 0, 0, UINT32_MAX};
+static unsigned long s_lastSample = 0;
+
+void memStatsUpdate()
+{
+    uint32_t freeHeap;
+    uint32_t maxBlock;
+    uint8_t fragmentation;
+    ESP.getHeapStats(&freeHeap, &maxBlock, &fragmentation);
+
+    s_stats.freeHeap = freeHeap;
+    s_stats.maxFreeBlock = maxBlock;
+    s_stats.fragmentation = fragmentation;
+    s_stats.minFreeHeap = min(s_stats.minFreeHeap, freeHeap);
+    s_stats.maxFragmentation = max(s_stats.maxFragmentation, fragmentation);
+
+    // the core paints the loop stack at boot; this scans for the deepest use
+    s_stats.minFreeStack = ESP.getFreeContStack();
+    s_lastSample = millis();
+}
+
+void memStatsSample()
+{
+    if (millis() - s_lastSample >= MEM_STATS_INTERVAL_MS)
+    {
+        memStatsUpdate();
+    }
+}
+
+const MemStats &memStats()
+{
+    return s_stats;
+}
+
+void memStatsPrint(Print &out)
+{
+    memStatsUpdate();
+    out.printf("heap free %u (min %u), max block %u\n",
+               s_stats.freeHeap, s_stats.minFreeHeap, s_stats.maxFreeBlock);
+    out.printf("fragmentation %u%% (max %u%%)\n",
+               s_stats.fragmentation, s_stats.maxFragmentation);
+    out.printf("stack never used %u\n", s_stats.minFreeStack);
+}
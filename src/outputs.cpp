@@ -0,0 +1,49 @@
+/**
+ * @file outputs.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Digital outputs on native GPIO or a PCF8574 I2C expander
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "outputs.h"
+#include <Wire.h>
+
+static uint8_t s_port = 0; // logical levels, bit n is P(n)
+static bool s_started = false;
+static uint32_t s_writes = 0;
+
+static void sendPort()
+{
+    Wire.beginTransmission(OUTPUT_EXPANDER_ADDRESS);
+    Wire.write(OUTPUT_EXPANDER_ACTIVE_LOW ? static_cast<uint8_t>(~s_port) : s_port);
+    Wire.endTransmission();
+    s_writes++;
+}
+
+void expanderPinMode(uint8_t)
+{
+    // quasi-bidirectional: every pin is an output once written
+    if (!s_started)
+    {
+        // first expander pin: start the bus and put every output in the off state
+        Wire.begin(OUTPUT_EXPANDER_SDA, OUTPUT_EXPANDER_SCL);
+        s_started = true;
+        s_port = 0;
+        sendPort();
+    }
+}
+
+void expanderWrite(uint8_t bit, uint8_t level)
+{
+    uint8_t port = level ? (s_port | (1 << bit)) : (s_port & ~(1 << bit));
+    if (port != s_port && s_started)
+    {
+        s_port = port;
+        sendPort();
+    }
+}
+
+uint32_t expanderWrites()
+{
+    return s_writes;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file postMortem.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief The last events before a reset, kept in RTC user memory
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "postMortem.h"
+
+static constexpr uint32_t MAGIC = 0x504D5231; // 'PMR1'
+
+struct PostMortemHeader
+{
+    uint32_t magic;
+    uint32_t boots;
+};
+
+static constexpr uint32_t EVENTS_BLOCK = POSTMORTEM_RTC_BLOCK + sizeof(PostMortemHeader) / 4;
+
+static_assert(sizeof(PostMortemEvent) == 8, "an event is two RTC blocks");
+static_assert(EVENTS_BLOCK * 4 + POSTMORTEM_EVENTS * sizeof(PostMortemEvent) <= 512,
+              "the post-mortem ring runs past the end of RTC user memory");
+
+static PostMortemEvent s_found[POSTMORTEM_EVENTS]; // oldest first
+static uint8_t s_foundCount = 0;
+static rst_info s_reset = {};
+
+static uint16_t s_seq = 0;  // of the last event recorded
+static uint8_t s_slot = 0;  // where the next one goes
+
+static const char *const *s_stateNames = nullptr;
+static uint8_t s_stateCount = 0;
+static const char *const *s_eventNames = nullptr;
+static uint8_t s_eventCount = 0;
+
+static const char *const REASONS[] = {"power on", "hw watchdog", "exception", "sw watchdog",
+                                      "restart", "deep sleep", "reset pin"};
+static const char *const PROBES[] = {"sensor scan", "littlefs", "eeprom commit", "history add"};
+
+/// The sequence number after `seq`; 0 is kept for empty slots
+static uint16_t nextSeq(uint16_t seq)
+{
+    return seq == UINT16_MAX ? 1 : seq + 1;
+}
+
+void postMortemBegin()
+{
+    s_reset = *ESP.getResetInfoPtr();
+
+    PostMortemHeader header;
+    PostMortemEvent ring[POSTMORTEM_EVENTS];
+    const bool valid =
+        ESP.rtcUserMemoryRead(POSTMORTEM_RTC_BLOCK, reinterpret_cast<uint32_t *>(&header), sizeof(header)) &&
+        ESP.rtcUserMemoryRead(EVENTS_BLOCK, reinterpret_cast<uint32_t *>(ring), sizeof(ring)) &&
+        header.magic == MAGIC;
+    if (!valid)
+    {
+        header = {MAGIC, 0};
+        memset(ring, 0, sizeof(ring));
+        ESP.rtcUserMemoryWrite(EVENTS_BLOCK, reinterpret_cast<uint32_t *>(ring), sizeof(ring));
+    }
+    header.boots++;
+    ESP.rtcUserMemoryWrite(POSTMORTEM_RTC_BLOCK, reinterpret_cast<uint32_t *>(&header), sizeof(header));
+
+    // the newest event is the one not followed by the next in sequence
+    uint8_t newest = POSTMORTEM_EVENTS;
+    for (uint8_t i = 0; i < POSTMORTEM_EVENTS; i++)
+    {
+        if (ring[i].seq && ring[(i + 1) % POSTMORTEM_EVENTS].seq != nextSeq(ring[i].seq))
+        {
+            newest = i;
+            break;
+        }
+    }
+
+    s_foundCount = 0;
+    if (newest < POSTMORTEM_EVENTS)
+    {
+        // back from there while the sequence holds
+        uint8_t oldest = newest;
+        s_foundCount = 1;
+        while (s_foundCount < POSTMORTEM_EVENTS)
+        {
+            const uint8_t before = (oldest + POSTMORTEM_EVENTS - 1) % POSTMORTEM_EVENTS;
+            if (!ring[before].seq || nextSeq(ring[before].seq) != ring[oldest].seq)
+            {
+                break;
+            }
+            oldest = before;
+            s_foundCount++;
+        }
+        for (uint8_t i = 0; i < s_foundCount; i++)
+        {
+            s_found[i] = ring[(oldest + i) % POSTMORTEM_EVENTS];
+        }
+        s_seq = ring[newest].seq;
+        s_slot = (newest + 1) % POSTMORTEM_EVENTS;
+    }
+    postMortemRecord(PM_BOOT, s_reset.reason);
+}
+
+void postMortemRecord(uint8_t kind, uint8_t arg)
+{
+    s_seq = nextSeq(s_seq);
+    PostMortemEvent event = {s_seq, kind, arg, static_cast<uint32_t>(millis())};
+    ESP.rtcUserMemoryWrite(EVENTS_BLOCK + s_slot * sizeof(PostMortemEvent) / 4,
+                           reinterpret_cast<uint32_t *>(&event), sizeof(event));
+    s_slot = (s_slot + 1) % POSTMORTEM_EVENTS;
+}
+
+void postMortemNames(const char *const states[], uint8_t stateCount, const char *const events[], uint8_t eventCount)
+{
+    s_stateNames = states;
+    s_stateCount = stateCount;
+    s_eventNames = events;
+    s_eventCount = eventCount;
+}
+
+const rst_info &postMortemReset()
+{
+    return s_reset;
+}
+
+const char *postMortemReason()
+{
+    return s_reset.reason < sizeof(REASONS) / sizeof(REASONS[0]) ? REASONS[s_reset.reason] : "unknown";
+}
+
+bool postMortemCrashed()
+{
+    return s_reset.reason == REASON_WDT_RST || s_reset.reason == REASON_EXCEPTION_RST ||
+           s_reset.reason == REASON_SOFT_WDT_RST;
+}
+
+uint8_t postMortemCount()
+{
+    return s_foundCount;
+}
+
+const PostMortemEvent &postMortemEvent(uint8_t index)
+{
+    return s_found[index];
+}
+
+static const char *named(const char *const names[], uint8_t count, uint8_t index, char *number)
+{
+    if (names && index < count)
+    {
+        return names[index];
+    }
+    snprintf(number, 4, "%u", index);
+    return number;
+}
+
+void postMortemDescribe(const PostMortemEvent &event, char *text, size_t size)
+{
+    char number[4];
+    switch (event.kind)
+    {
+    case PM_BOOT:
+        snprintf(text, size, "boot %s", event.arg < sizeof(REASONS) / sizeof(REASONS[0]) ? REASONS[event.arg] : "?");
+        break;
+    case PM_STATE:
+        snprintf(text, size, "state %s", named(s_stateNames, s_stateCount, event.arg, number));
+        break;
+    case PM_INPUT:
+        snprintf(text, size, "in %s", named(s_eventNames, s_eventCount, event.arg, number));
+        break;
+    case PM_HEATER:
+    case PM_CLEANER:
+        snprintf(text, size, "%s %u %s", event.kind == PM_HEATER ? "heater" : "cleaner",
+                 (event.arg & ~POSTMORTEM_ON) + 1, event.arg & POSTMORTEM_ON ? "on" : "off");
+        break;
+    case PM_PROBE:
+        snprintf(text, size, "> %s", named(PROBES, sizeof(PROBES) / sizeof(PROBES[0]), event.arg, number));
+        break;
+    default:
+        snprintf(text, size, "? %u %u", event.kind, event.arg);
+        break;
+    }
+}
+
+void postMortemPrint(Print &out)
+{
+    out.printf("POSTMORTEM reset=\"%s\" exccause=%u epc1=0x%08x excvaddr=0x%08x depc=0x%08x events=%u\n",
+               postMortemReason(), s_reset.exccause, s_reset.epc1, s_reset.excvaddr, s_reset.depc, s_foundCount);
+    char text[32];
+    for (uint8_t i = 0; i < s_foundCount; i++)
+    {
+        postMortemDescribe(s_found[i], text, sizeof(text));
+        out.printf("POSTMORTEM seq=%u ms=%u %s\n", s_found[i].seq, s_found[i].ms, text);
+    }
+}
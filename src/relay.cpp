@@ -0,0 +1,133 @@
+/**
+ * @file relay.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Relay actuation with minimum dwell, hysteresis and switch-rate limits
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "relay.h"
+
+static constexpr uint32_t MINUTE_MS = 60000;
+
+Relay::Relay(uint8_t pin, const RelayConfig &config)
+    : _pin(pin), _config(config)
+{
+}
+
+void Relay::begin()
+{
+    outputPinMode(_pin);
+    outputWrite(_pin, LOW);
+    _on = false;
+    _creditMs = MINUTE_MS; // a full minute's budget to start with
+}
+
+bool Relay::request(bool on, uint32_t nowMs)
+{
+    if (on == _on)
+    {
+        return _on;
+    }
+
+    // dwell: stay put until the current state has lasted long enough
+    if (nowMs - _changedMs < (_on ? _config.minOnMs : _config.minOffMs))
+    {
+        _held++;
+        return _on;
+    }
+
+    // rate: the budget refills at a minute per minute, up to one minute
+    uint32_t cost = 0;
+    if (_config.maxPerMinute)
+    {
+        _creditMs = min(_creditMs + (nowMs - _creditAtMs), MINUTE_MS);
+        _creditAtMs = nowMs;
+        cost = MINUTE_MS / _config.maxPerMinute;
+        if (_creditMs < cost)
+        {
+            _held++;
+            return _on;
+        }
+    }
+    _creditMs -= cost;
+    apply(on, nowMs);
+    return _on;
+}
+
+bool Relay::requestBelow(float value, float threshold, uint32_t nowMs)
+{
+    return request(wantBelow(value, threshold), nowMs);
+}
+
+bool Relay::requestAbove(float value, float threshold, uint32_t nowMs)
+{
+    return request(wantAbove(value, threshold), nowMs);
+}
+
+bool Relay::wantBelow(float value, float threshold) const
+{
+    if (value >= threshold)
+    {
+        return false;
+    }
+    if (value < threshold - _config.hysteresis)
+    {
+        return true;
+    }
+    return _on;
+}
+
+bool Relay::wantAbove(float value, float threshold) const
+{
+    if (value >= threshold)
+    {
+        return true;
+    }
+    if (value < threshold - _config.hysteresis)
+    {
+        return false;
+    }
+    return _on;
+}
+
+void Relay::forceOff(uint32_t nowMs)
+{
+    if (_on)
+    {
+        apply(false, nowMs);
+    }
+}
+
+void Relay::apply(bool on, uint32_t nowMs)
+{
+    uint64_t nowUs = micros64();
+    if (_on)
+    {
+        _onUs += nowUs - _onSinceUs;
+    }
+    _onSinceUs = nowUs;
+    outputWrite(_pin, on ? HIGH : LOW);
+    _on = on;
+    _changedMs = nowMs;
+    _switches++;
+}
+
+uint64_t Relay::onMicros() const
+{
+    return _on ? _onUs + (micros64() - _onSinceUs) : _onUs;
+}
+
+void requestExclusive(Relay &first, bool firstOn, Relay &second, bool secondOn, uint32_t nowMs)
+{
+    if (firstOn)
+    {
+        second.request(false, nowMs);
+        if (!second.isOn())
+        {
+            first.request(true, nowMs);
+        }
+        return;
+    }
+    first.request(false, nowMs);
+    second.request(secondOn && !first.isOn(), nowMs);
+}
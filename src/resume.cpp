@@ -0,0 +1,61 @@
+/**
+ * @file resume.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Checkpoint of the running cycle in RTC user memory, for resuming after a reset
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "resume.h"
+
+static constexpr uint32_t MAGIC = 0x52534D31; // 'RSM1'
+static constexpr size_t CRC_BYTES = offsetof(ResumeCheckpoint, crc);
+
+static_assert(sizeof(ResumeCheckpoint) % 4 == 0, "RTC memory is written in 4 byte blocks");
+
+static uint32_t s_saveUs = 0;
+
+uint32_t rtcCrc32(const void *record, size_t length)
+{
+    const uint8_t *data = static_cast<const uint8_t *>(record);
+    uint32_t crc = 0xFFFFFFFF;
+    while (length--)
+    {
+        crc ^= *data++;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+void resumeSave(ResumeCheckpoint &checkpoint)
+{
+    uint32_t start = micros();
+    checkpoint.magic = MAGIC;
+    checkpoint.crc = rtcCrc32(&checkpoint, CRC_BYTES);
+    ESP.rtcUserMemoryWrite(RESUME_RTC_BLOCK, reinterpret_cast<uint32_t *>(&checkpoint), sizeof(checkpoint));
+    s_saveUs = micros() - start;
+}
+
+bool resumeLoad(ResumeCheckpoint &checkpoint)
+{
+    if (!ESP.rtcUserMemoryRead(RESUME_RTC_BLOCK, reinterpret_cast<uint32_t *>(&checkpoint), sizeof(checkpoint)))
+    {
+        return false;
+    }
+    return checkpoint.magic == MAGIC &&
+           checkpoint.channels <= RESUME_MAX_CHANNELS &&
+           checkpoint.crc == rtcCrc32(&checkpoint, CRC_BYTES);
+}
+
+void resumeClear()
+{
+    uint32_t none = 0;
+    ESP.rtcUserMemoryWrite(RESUME_RTC_BLOCK, &none, sizeof(none));
+}
+
+uint32_t resumeSaveMicros()
+{
+    return s_saveUs;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file tempSampler.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Adaptive-resolution, filtered sampling of the DS18B20 bath sensor
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "tempSampler.h"
+
+// A 12 bit reading is 1/16 C; every bit less doubles the step.
+static float quantStepF(uint8_t resolution)
+{
+    return 0.0625f * 1.8f * static_cast<float>(1 << (12 - resolution));
+}
+
+TempSampler::TempSampler(DallasTemperature &sensors, uint8_t index)
+    : _sensors(sensors), _index(index)
+{
+}
+
+bool TempSampler::begin()
+{
+    if (_sensors.getDeviceCount() == 0)
+    {
+        _sensors.begin();
+    }
+    _present = _sensors.getAddress(_address, _index);
+    if (!_present)
+    {
+        return false;
+    }
+
+    // don't burn the sensor's EEPROM every time the resolution changes
+    _sensors.setAutoSaveScratchPad(false);
+    _sensors.setWaitForConversion(false);
+
+    // nothing is known yet, so get the first reading as fast as possible
+    _resolution = 9;
+    _sensors.setResolution(_address, _resolution);
+    startConversion();
+    return true;
+}
+
+void TempSampler::configure(const TempSamplerConfig &config)
+{
+    _config = config;
+    _valid = false; // restart the filter from the next reading
+}
+
+uint8_t TempSampler::pickResolution() const
+{
+    if (!_valid)
+    {
+        return 9;
+    }
+    float error = fabsf(_targetF - _tempF);
+    if (error > _config.farBandF)
+    {
+        return 9;
+    }
+    if (error > _config.nearBandF)
+    {
+        return 10;
+    }
+    return 12;
+}
+
+void TempSampler::startConversion()
+{
+    _waitMs = _sensors.millisToWaitForConversion(_resolution);
+    _sensors.requestTemperaturesByAddress(_address);
+    _requestedAt = millis();
+    _converting = true;
+}
+
+bool TempSampler::update()
+{
+    if (!_present || !_converting)
+    {
+        return false;
+    }
+
+    uint32_t now = millis();
+    if (now - _requestedAt < _waitMs)
+    {
+        return false;
+    }
+    _lastConversionMs = static_cast<uint16_t>(now - _requestedAt);
+
+    float raw = _sensors.getTempF(_address);
+    bool good = raw > DEVICE_DISCONNECTED_F;
+    if (good)
+    {
+        float dt = _valid ? (now - _lastSampleAt) / 1000.0f : 0.0f;
+        _rawF = raw;
+        applyFilter(raw, dt);
+        _lastSampleAt = now;
+        _samples++;
+        _badReads = 0;
+    }
+    else if (++_badReads >= SAMPLER_MAX_BAD_READS)
+    {
+        _badReads = SAMPLER_MAX_BAD_READS;
+        _valid = false; // gone: don't let the controller act on a stale reading
+    }
+
+    // choose the next resolution from the fresh estimate and go again
+    uint8_t next = pickResolution();
+    if (next != _resolution)
+    {
+        _resolution = next;
+        _sensors.setResolution(_address, _resolution);
+    }
+    startConversion();
+    return good;
+}
+
+void TempSampler::applyFilter(float rawF, float dt)
+{
+    if (!_valid || dt <= 0.0f)
+    {
+        _tempF = rawF;
+        _rateFps = 0.0f;
+        _p00 = quantStepF(_resolution) * quantStepF(_resolution);
+        _p01 = 0.0f;
+        _p11 = 1.0f;
+        _valid = true;
+        return;
+    }
+
+    switch (_config.filter)
+    {
+    case FILTER_NONE:
+        _rateFps = (rawF - _tempF) / dt;
+        _tempF = rawF;
+        break;
+
+    case FILTER_LOWPASS:
+    {
+        float alpha = dt / (_config.filterParam + dt);
+        float previous = _tempF;
+        _tempF += alpha * (rawF - _tempF);
+        _rateFps += alpha * ((_tempF - previous) / dt - _rateFps);
+        break;
+    }
+
+    case FILTER_KALMAN:
+    default:
+    {
+        // predict: temperature moves at the current rate, the rate wanders
+        float q = _config.filterParam;
+        _tempF += _rateFps * dt;
+        _p00 += dt * (2.0f * _p01 + dt * _p11) + q * dt * dt * dt / 3.0f;
+        _p01 += dt * _p11 + q * dt * dt / 2.0f;
+        _p11 += q * dt;
+
+        // update: measurement noise is the quantisation noise of this resolution
+        float step = quantStepF(_resolution);
+        float r = step * step / 12.0f;
+        float innovation = rawF - _tempF;
+        float s = _p00 + r;
+        float k0 = _p00 / s;
+        float k1 = _p01 / s;
+        _tempF += k0 * innovation;
+        _rateFps += k1 * innovation;
+        _p11 -= k1 * _p01;
+        _p01 -= k0 * _p01;
+        _p00 -= k0 * _p00;
+        break;
+    }
+    }
+}
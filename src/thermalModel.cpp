@@ -0,0 +1,177 @@
+/**
+ * @file thermalModel.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Self-learning first order model of the bath, for ETA and coasting
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "thermalModel.h"
+
+static constexpr float FORGETTING = 0.995f;     // RLS forgetting factor (~200 sample memory)
+static constexpr uint16_t TRAINED_UPDATES = 30; // samples before predictions are used
+static constexpr float DEAD_TIME_DEFAULT = 20.0f;
+static constexpr float DEAD_TIME_MAX = 300.0f;
+static constexpr float RESPONSE_RATE_FPS = 0.5f / 60.0f; // rise that counts as "responded" before we know heatRate
+
+ThermalModel::ThermalModel()
+{
+    _params = {MAGIC, 0.0f, 0.0f, 0.0f, DEAD_TIME_DEFAULT, 0};
+    resetCovariance(100.0f);
+}
+
+void ThermalModel::resetCovariance(float scale)
+{
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            _p[i][j] = (i == j) ? scale : 0.0f;
+        }
+    }
+}
+
+void ThermalModel::load(const Params &params)
+{
+    if (params.magic != MAGIC || !(params.deadTimeS >= 0.0f && params.deadTimeS <= DEAD_TIME_MAX))
+    {
+        return;
+    }
+    _params = params;
+    // trust what we already learned, but let it keep adapting
+    resetCovariance(trained() ? 1.0f : 100.0f);
+    _dirty = false;
+}
+
+bool ThermalModel::trained() const
+{
+    return _params.updates >= TRAINED_UPDATES && _params.heatRate > 0.0f;
+}
+
+void ThermalModel::observe(uint32_t nowMs, float tempF, float rateFps, bool heaterOn)
+{
+    // time the dead time from every off->on edge until the rate picks up
+    if (heaterOn != _lastHeater)
+    {
+        _edgeMs = nowMs;
+        _lastHeater = heaterOn;
+        _timingDeadTime = heaterOn;
+        _edgeRate = rateFps;
+    }
+    float sinceEdge = (nowMs - _edgeMs) / 1000.0f;
+    if (_timingDeadTime)
+    {
+        float threshold = trained() ? 0.3f * _params.heatRate : RESPONSE_RATE_FPS;
+        if (rateFps - _edgeRate > threshold)
+        {
+            _params.deadTimeS += 0.3f * (sinceEdge - _params.deadTimeS);
+            _timingDeadTime = false;
+        }
+        else if (sinceEdge > DEAD_TIME_MAX)
+        {
+            _timingDeadTime = false; // never responded (lid off? sensor out of the water?)
+        }
+    }
+
+    // the sensor sees what the heater did one dead time ago
+    float u = (sinceEdge >= _params.deadTimeS) ? (heaterOn ? 1.0f : 0.0f)
+                                               : (heaterOn ? 0.0f : 1.0f);
+    float phi[3] = {u, -(tempF - T_REF), 1.0f};
+    float theta[3] = {_params.heatRate, _params.lossCoeff, _params.drift};
+
+    // recursive least squares: K = P.phi / (lambda + phi'.P.phi)
+    float pphi[3];
+    float denom = FORGETTING;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        pphi[i] = _p[i][0] * phi[0] + _p[i][1] * phi[1] + _p[i][2] * phi[2];
+        denom += phi[i] * pphi[i];
+    }
+    float error = rateFps - (theta[0] * phi[0] + theta[1] * phi[1] + theta[2] * phi[2]);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        theta[i] += pphi[i] / denom * error;
+    }
+    // forget only while P is small (see RLS_COVARIANCE_MAX)
+    float trace = 0.0f;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            _p[i][j] -= pphi[i] * pphi[j] / denom;
+        }
+        trace += _p[i][i];
+    }
+    if (trace < RLS_COVARIANCE_MAX)
+    {
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            for (uint8_t j = 0; j < 3; j++)
+            {
+                _p[i][j] /= FORGETTING;
+            }
+        }
+    }
+
+    // physical limits: heating can't cool and losses can't heat
+    _params.heatRate = max(theta[0], 0.0f);
+    _params.lossCoeff = max(theta[1], 0.0f);
+    _params.drift = theta[2];
+    if (_params.updates < UINT16_MAX)
+    {
+        _params.updates++;
+    }
+    _dirty = true;
+}
+
+long ThermalModel::etaSeconds(float tempF, float targetF, bool heaterOn) const
+{
+    if (tempF >= targetF)
+    {
+        return 0;
+    }
+    if (!trained())
+    {
+        return -1;
+    }
+
+    // a switched-off heater has to switch on and get through the dead time first
+    float seconds = heaterOn ? 0.0f : _params.deadTimeS;
+    float a = _params.heatRate + _params.drift;
+    float b = _params.lossCoeff;
+
+    if (b < 1e-6f)
+    {
+        // losses too small to matter: straight line
+        if (a <= 0.0f)
+        {
+            return -1;
+        }
+        seconds += (targetF - tempF) / a;
+    }
+    else
+    {
+        // exponential approach to T_final = T_REF + a / b
+        float finalF = T_REF + a / b;
+        if (finalF <= targetF)
+        {
+            return -1; // the heater can't get there
+        }
+        seconds += logf((finalF - tempF) / (finalF - targetF)) / b;
+    }
+    return static_cast<long>(seconds + 0.5f);
+}
+
+float ThermalModel::coastRiseF(float rateFps) const
+{
+    if (!trained() || rateFps <= 0.0f)
+    {
+        return 0.0f;
+    }
+    // the heat already on its way keeps arriving for one dead time
+    return rateFps * _params.deadTimeS;
+}
+
+bool ThermalModel::shouldCoast(float tempF, float rateFps, float targetF) const
+{
+    return tempF + coastRiseF(rateFps) >= targetF;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file timerPresets.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief User-defined (time, temperature) presets, most recently used first
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "timerPresets.h"
+
+// the times the old fixed list offered most often
+static const uint8_t DEFAULT_MINUTES[] = {10, 20, 30};
+
+bool TimerPresets::valid() const
+{
+    if (count == 0 || count > PRESET_MAX)
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (preset[i].minutes == 0 || preset[i].temperatureF == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TimerPresets::reset(Preset current)
+{
+    count = 0;
+    reserved = 0;
+    for (int8_t i = sizeof(DEFAULT_MINUTES) - 1; i >= 0; i--)
+    {
+        add({DEFAULT_MINUTES[i], current.temperatureF});
+    }
+    add(current);
+}
+
+int8_t TimerPresets::find(Preset p) const
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (preset[i] == p)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void TimerPresets::use(uint8_t index)
+{
+    if (index >= count)
+    {
+        return;
+    }
+    Preset p = preset[index];
+    memmove(&preset[1], &preset[0], index * sizeof(Preset));
+    preset[0] = p;
+}
+
+void TimerPresets::add(Preset p)
+{
+    int8_t existing = find(p);
+    if (existing >= 0)
+    {
+        use(existing);
+        return;
+    }
+    if (count < PRESET_MAX)
+    {
+        count++;
+    }
+    memmove(&preset[1], &preset[0], (count - 1) * sizeof(Preset));
+    preset[0] = p;
+}
+
+uint8_t TimerPresets::edit(uint8_t index, Preset p)
+{
+    if (index >= count)
+    {
+        return 0;
+    }
+    int8_t existing = find(p);
+    if (existing >= 0 && existing != index)
+    {
+        remove(existing);
+        if (existing < index)
+        {
+            index--;
+        }
+    }
+    preset[index] = p;
+    return index;
+}
+
+void TimerPresets::remove(uint8_t index)
+{
+    if (index >= count || count == 1)
+    {
+        return;
+    }
+    count--;
+    memmove(&preset[index], &preset[index + 1], (count - index) * sizeof(Preset));
+}
@@ -0,0 +1,72 @@
+/**
+ * @file timezones.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief Lookup of POSIX TZ rules by zone name
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ */
+#include "timezones.h"
+#include "zonesTable.h" // generated into the build directory by scripts/gen_zones.py
+
+static_assert(TZ_RULE_LONGEST < TZ_RULE_MAX, "a zone rule won't fit in TZ_RULE_MAX");
+
+static PGM_P poolString(uint16_t index, uint8_t field)
+{
+    return TZ_POOL + pgm_read_word(&TZ_INDEX[index][field]);
+}
+
+static bool copyField(uint16_t index, uint8_t field, char *out, size_t outLen)
+{
+    if (index >= TZ_COUNT || outLen == 0)
+    {
+        return false;
+    }
+    strncpy_P(out, poolString(index, field), outLen - 1);
+    out[outLen - 1] = '\0';
+    return true;
+}
+
+uint16_t tzCount()
+{
+    return TZ_COUNT;
+}
+
+int16_t tzFind(const char *name)
+{
+    int16_t low = 0;
+    int16_t high = TZ_COUNT - 1;
+    while (low <= high)
+    {
+        int16_t mid = (low + high) / 2;
+        int cmp = strcmp_P(name, poolString(mid, 0));
+        if (cmp == 0)
+        {
+            return mid;
+        }
+        if (cmp < 0)
+        {
+            high = mid - 1;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+    return -1;
+}
+
+bool tzName(uint16_t index, char *out, size_t outLen)
+{
+    return copyField(index, 0, out, outLen);
+}
+
+bool tzRule(uint16_t index, char *out, size_t outLen)
+{
+    return copyField(index, 1, out, outLen);
+}
+
+bool tzLookup(const char *name, char *out, size_t outLen)
+{
+    int16_t index = tzFind(name);
+    return index >= 0 && tzRule(index, out, outLen);
+}
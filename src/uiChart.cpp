@@ -0,0 +1,127 @@
+/**
+ * @file uiChart.cpp
+ * @author Kevin Murphy (https://www.SomerledDesign.com)
+ * @brief The screens and the cleaning cycle as one state chart
+ *
+ * @copyright Copyright (c) 2024 Somerled Design, LLC in Kevin Murphy
+ *
+ * Transitions for the same state and event are listed together, first
+ * match wins; StateChart refuses to build otherwise.
+ */
+#include "uiChart.h"
+
+static constexpr Guard MENU_AT = {menuAt, "menu at"};
+static constexpr Guard RESUME_PENDING = {resumePending, "resume pending"};
+static constexpr Guard NEW_PRESET = {presetIsNew, "new preset"};
+static constexpr Guard CRASHED = {resetCrashed, "crashed"};
+
+static constexpr StateDef STATES[ST_COUNT] = {
+    // parent, name, enter, exit, run, timeout
+    {NO_STATE, "root"},
+    {ST_ROOT, "splash", splashEnter, nullptr, splashRun},
+    {ST_ROOT, "idle"},
+    {ST_IDLE, "menu", nullptr, nullptr, displayMenu},
+    {ST_IDLE, "settings", nullptr, settingsExit},
+    {ST_SETTINGS, "set_timer", setTimerEnter, nullptr, setTimerRun},
+    {ST_SET_TIMER, "edit_preset", editPresetEnter, nullptr, editPresetRun},
+    {ST_SETTINGS, "set_temp", setTempEnter, nullptr, setTempRun},
+    {ST_SETTINGS, "network"}, // TODO: network settings
+    {ST_SETTINGS, "contrast", contrastEnter, nullptr, contrastRun},
+    {ST_SETTINGS, "cleaner_mode", cleanerModeEnter, nullptr, cleanerModeRun},
+    {ST_IDLE, "info"},
+    {ST_INFO, "memory", memoryEnter, nullptr, memoryRun},
+    {ST_INFO, "diagnostics", diagnosticsEnter, nullptr, diagnosticsRun},
+    {ST_INFO, "energy", nullptr, nullptr, energyRun, ENERGY_SUMMARY_MS},
+    {ST_INFO, "history", historyEnter, nullptr, historyRun},
+    {ST_INFO, "last_reset", lastResetEnter, nullptr, lastResetRun},
+    {ST_IDLE, "resume", nullptr, nullptr, resumeRun, RESUME_OFFER_MS},
+    {ST_IDLE, "ready_in", nullptr, nullptr, readyInRun},
+    {ST_ROOT, "delayed", nullptr, nullptr, delayedRun},
+    {ST_ROOT, "cycle", cycleEnter, cycleExit},
+    {ST_CYCLE, "timer", nullptr, nullptr, timerRun},
+};
+
+static constexpr Transition TRANSITIONS[] = {
+    // from, event, to, action, guard, guard's argument
+    {ST_SPLASH, EV_BOOTED, ST_RESUME, nullptr, &RESUME_PENDING},
+    {ST_SPLASH, EV_BOOTED, ST_LAST_RESET, nullptr, &CRASHED},
+    {ST_SPLASH, EV_BOOTED, ST_MENU},
+
+    {ST_MENU, EV_UP, NO_STATE, menuPrevious},
+    {ST_MENU, EV_DOWN, NO_STATE, menuNext},
+    {ST_MENU, EV_CLICK, ST_READY_IN, nullptr, &MENU_AT, READY_IN},
+    {ST_MENU, EV_CLICK, ST_SET_TIMER, nullptr, &MENU_AT, SET_TIMER},
+    {ST_MENU, EV_CLICK, ST_SET_TEMP, nullptr, &MENU_AT, SET_TEMP},
+    {ST_MENU, EV_CLICK, ST_NETWORK, nullptr, &MENU_AT, NETWORK},
+    {ST_MENU, EV_CLICK, ST_CONTRAST, nullptr, &MENU_AT, CONTRAST},
+    {ST_MENU, EV_CLICK, ST_CLEANER_MODE, nullptr, &MENU_AT, CLEANER_MODE},
+    {ST_MENU, EV_CLICK, ST_HISTORY, nullptr, &MENU_AT, HISTORY},
+    {ST_MENU, EV_HOLD, ST_TIMER, cycleStart, &MENU_AT, START_TIMER},
+    {ST_MENU, EV_HOLD, NO_STATE, toggleBacklight},
+    {ST_MENU, EV_DOUBLE, ST_DIAGNOSTICS},
+    {ST_MENU, EV_TRIPLE, ST_MEMORY},
+
+    {ST_SET_TIMER, EV_UP, NO_STATE, setTimerPrevious},
+    {ST_SET_TIMER, EV_DOWN, NO_STATE, setTimerNext},
+    {ST_SET_TIMER, EV_CLICK, ST_EDIT_PRESET, nullptr, &NEW_PRESET},
+    {ST_SET_TIMER, EV_CLICK, ST_MENU, setTimerUse},
+    {ST_SET_TIMER, EV_HOLD, ST_EDIT_PRESET},
+
+    {ST_EDIT_PRESET, EV_UP, NO_STATE, editPresetDecrement},
+    {ST_EDIT_PRESET, EV_DOWN, NO_STATE, editPresetIncrement},
+    {ST_EDIT_PRESET, EV_CLICK, NO_STATE, editPresetNextField},
+    {ST_EDIT_PRESET, EV_HOLD, ST_SET_TIMER, editPresetSave},
+
+    {ST_SET_TEMP, EV_UP, NO_STATE, setTempDecrement},
+    {ST_SET_TEMP, EV_DOWN, NO_STATE, setTempIncrement},
+    {ST_SET_TEMP, EV_CLICK, NO_STATE, setTempNextDigit},
+    {ST_SET_TEMP, EV_HOLD, ST_MENU, setTempSave},
+
+    {ST_NETWORK, EV_CLICK, ST_MENU},
+    {ST_NETWORK, EV_HOLD, ST_MENU},
+
+    {ST_CONTRAST, EV_UP, NO_STATE, contrastUp},
+    {ST_CONTRAST, EV_DOWN, NO_STATE, contrastDown},
+    {ST_CONTRAST, EV_HOLD, ST_MENU},
+
+    {ST_CLEANER_MODE, EV_UP, NO_STATE, cleanerModeNext},
+    {ST_CLEANER_MODE, EV_DOWN, NO_STATE, cleanerModePrevious},
+    {ST_CLEANER_MODE, EV_HOLD, ST_MENU, cleanerModeSave},
+
+    {ST_INFO, EV_CLICK, ST_MENU},
+    {ST_INFO, EV_HOLD, ST_MENU},
+    {ST_INFO, EV_DOUBLE, ST_MENU},
+    {ST_INFO, EV_TRIPLE, ST_MENU},
+
+    {ST_DIAGNOSTICS, EV_UP, NO_STATE, diagnosticsScrollUp},
+    {ST_DIAGNOSTICS, EV_DOWN, NO_STATE, diagnosticsScrollDown},
+    {ST_DIAGNOSTICS, EV_CLICK, ST_LAST_RESET},
+
+    {ST_ENERGY, EV_TIMEOUT, ST_MENU},
+
+    {ST_HISTORY, EV_UP, NO_STATE, historyNewer},
+    {ST_HISTORY, EV_DOWN, NO_STATE, historyOlder},
+
+    {ST_LAST_RESET, EV_UP, NO_STATE, lastResetScrollUp},
+    {ST_LAST_RESET, EV_DOWN, NO_STATE, lastResetScrollDown},
+
+    {ST_RESUME, EV_CLICK, ST_TIMER, resumeAccept},
+    {ST_RESUME, EV_HOLD, ST_MENU, resumeDecline},
+    {ST_RESUME, EV_TIMEOUT, ST_MENU, resumeDecline},
+
+    {ST_READY_IN, EV_UP, NO_STATE, readyInDecrement},
+    {ST_READY_IN, EV_DOWN, NO_STATE, readyInIncrement},
+    {ST_READY_IN, EV_CLICK, ST_DELAYED, delayedArm},
+    {ST_READY_IN, EV_HOLD, ST_MENU},
+
+    {ST_DELAYED, EV_HEAT, ST_TIMER, delayedHeat},
+    {ST_DELAYED, EV_HOLD, ST_MENU},
+
+    {ST_CYCLE, EV_HOLD, ST_ENERGY, cycleStopped},
+    {ST_CYCLE, EV_CYCLE_DONE, ST_ENERGY, cycleFinished},
+};
+
+static constexpr const char *EVENT_NAMES[EV_COUNT] = {
+    "click", "hold", "double", "triple", "up", "down", "timeout", "booted", "cycle done", "heat"};
+
+constexpr UiChart UI_CHART(STATES, TRANSITIONS, EVENT_NAMES, EV_TIMEOUT);